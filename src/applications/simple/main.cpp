@@ -3,34 +3,57 @@
 #include <string>
 #include <cmath>
 #include <utility>
-// #include <nlohmann/json.hpp>
+#include <cstdlib>
 #include "reference_testing/reference_testing.h"
+#include "reference_testing/check_plan.h"
 
 using namespace lumos;
 
 bool ReferenceDataShouldGenerate()
 {
-  return true;
+  // Regeneration is the default, LUMOS_GENERATE_REFERENCE_DATA=0 only loads
+  const char *generate = std::getenv("LUMOS_GENERATE_REFERENCE_DATA");
+  return generate == nullptr || std::string(generate) != "0";
+}
+
+ReferenceStore &GetReferenceStore()
+{
+  static ReferenceStore store("reference_store");
+  return store;
 }
 
 template <typename T>
 std::vector<T> GetReferenceData(const std::string &name, const std::vector<T> &value_vec, const T offset_value)
 {
+  ReferenceStore &store = GetReferenceStore();
   if (!ReferenceDataShouldGenerate())
   {
-    return loadBinaryVector<T>(name + ".bin");
+    return store.get<T>(name);
   }
   else
   {
-    std::vector<T> adjusted_values(value_vec.size());
-
-    for (size_t k = 0; k < value_vec.size(); ++k)
+    // The reference is derived from every sample of value_vec and the offset,
+    // so both go into the parameter hash. A change to the generator's length,
+    // sample rate or amplitude then regenerates instead of loading a stale
+    // reference, while unchanged data is neither rewritten nor duplicated.
+    XXHash64 hasher;
+    const uint64_t sample_count = value_vec.size();
+    hasher.update(&sample_count, sizeof(sample_count));
+    hasher.update(value_vec.data(), value_vec.size() * sizeof(T));
+    hasher.update(&offset_value, sizeof(offset_value));
+
+    auto generate = [&]()
     {
-      adjusted_values[k] = value_vec[k] + offset_value;
-    }
+      std::vector<T> adjusted_values(value_vec.size());
+
+      for (size_t k = 0; k < value_vec.size(); ++k)
+      {
+        adjusted_values[k] = value_vec[k] + offset_value;
+      }
+      return adjusted_values;
+    };
 
-    saveBinaryVector<T>(adjusted_values, name + ".bin");
-    return adjusted_values;
+    return store.getOrGenerate<T>(name, hasher.digest(), generate);
   }
 }
 
@@ -87,6 +110,20 @@ void MyTestMethod()
   plot(t_d, x_max_d);
   plot(t_d, x_ref_d);
 
+  // Suites can also be given as a JSON check plan, see check_plan.h
+  if (const char *plan_file = std::getenv("LUMOS_CHECK_PLAN"))
+  {
+    using Channels = std::vector<std::pair<std::string, std::vector<double>>>;
+    const SignalSet<double> test_signals(t, Channels{{"x", x}});
+    const SignalSet<double> reference_signals(t, Channels{{"x_min", x_min}, {"x_max", x_max}, {"x_ref", x_ref}});
+
+    const CheckPlan plan = CheckPlan::load(plan_file);
+    for (const CheckResult<double> &result : plan.bind(test_signals, reference_signals).evaluate())
+    {
+      EXPECT_TRUE(result.passed, result.name);
+    }
+  }
+
   /*TEST_METHOD("Some name for dvs window")
   {
     EXPECT_TRUE(isWithinBounds(x, x_min, x_max), "x is within bounds");
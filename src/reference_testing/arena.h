@@ -0,0 +1,158 @@
+#pragma once
+
+#include <vector>
+#include <memory_resource>
+#include <new>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace lumos
+{
+
+  // Monotonic arena for loaders, resampling outputs and checker temporaries.
+  // Allocation bumps a pointer and deallocation is a no-op; reset() makes
+  // the whole arena available again without returning memory upstream.
+  // When a run needed more than one block, reset() merges them into a single
+  // block of the combined size, so once a run of the same shape has been
+  // seen, later runs do no heap allocations at all.
+  //
+  //   MonotonicArena arena;
+  //   for (const std::string &run : runs)
+  //   {
+  //     arena.reset();
+  //     std::pmr::vector<double> x = loadBinaryVector<double>(run, ArenaAllocator<double>(&arena));
+  //     ...
+  //   }
+  //
+  // It plugs in wherever a std::pmr::memory_resource is accepted. Not
+  // thread-safe; use one arena per thread.
+  class MonotonicArena : public std::pmr::memory_resource
+  {
+  public:
+    static constexpr size_t kDefaultBlockSize = size_t(1) << 16;
+    static constexpr size_t kBlockAlignment = 64;
+
+    explicit MonotonicArena(size_t initial_block_size = kDefaultBlockSize)
+        : next_block_size_(std::max<size_t>(initial_block_size, kBlockAlignment)), current_(0), offset_(0),
+          used_(0), upstream_allocations_(0)
+    {
+    }
+
+    ~MonotonicArena() override
+    {
+      for (const Block &block : blocks_)
+      {
+        freeBlock(block);
+      }
+    }
+
+    MonotonicArena(const MonotonicArena &) = delete;
+    MonotonicArena &operator=(const MonotonicArena &) = delete;
+
+    // Invalidates everything allocated from the arena
+    void reset()
+    {
+      if (blocks_.size() > 1)
+      {
+        size_t total = 0;
+        for (const Block &block : blocks_)
+        {
+          total += block.size;
+          freeBlock(block);
+        }
+        blocks_.clear();
+        addBlock(total);
+      }
+      current_ = 0;
+      offset_ = 0;
+      used_ = 0;
+    }
+
+    // Bytes handed out since the last reset, including alignment padding
+    size_t used() const { return used_; }
+
+    size_t capacity() const
+    {
+      size_t total = 0;
+      for (const Block &block : blocks_)
+      {
+        total += block.size;
+      }
+      return total;
+    }
+
+    size_t blockCount() const { return blocks_.size(); }
+
+    // Number of blocks requested from the heap over the arena's lifetime
+    size_t upstreamAllocations() const { return upstream_allocations_; }
+
+  protected:
+    void *do_allocate(size_t bytes, size_t alignment) override
+    {
+      while (current_ < blocks_.size())
+      {
+        const Block &block = blocks_[current_];
+        const uintptr_t base = reinterpret_cast<uintptr_t>(block.data);
+        const uintptr_t aligned = (base + offset_ + alignment - 1) / alignment * alignment;
+        const size_t end = static_cast<size_t>(aligned - base) + bytes;
+        if (end <= block.size)
+        {
+          used_ += end - offset_;
+          offset_ = end;
+          return reinterpret_cast<void *>(aligned);
+        }
+
+        current_++;
+        offset_ = 0;
+      }
+
+      addBlock(std::max(next_block_size_, bytes + alignment));
+      next_block_size_ *= 2;
+      return do_allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *, size_t, size_t) override
+    {
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+      return this == &other;
+    }
+
+  private:
+    struct Block
+    {
+      char *data;
+      size_t size;
+    };
+
+    void addBlock(size_t size)
+    {
+      size = (size + kBlockAlignment - 1) / kBlockAlignment * kBlockAlignment;
+      blocks_.push_back(Block{static_cast<char *>(::operator new(size, std::align_val_t(kBlockAlignment))), size});
+      upstream_allocations_++;
+      next_block_size_ = std::max(next_block_size_, size);
+    }
+
+    static void freeBlock(const Block &block)
+    {
+      ::operator delete(block.data, std::align_val_t(kBlockAlignment));
+    }
+
+    std::vector<Block> blocks_;
+    size_t next_block_size_;
+    size_t current_;
+    size_t offset_;
+    size_t used_;
+    size_t upstream_allocations_;
+  };
+
+  template <typename T>
+  using ArenaAllocator = std::pmr::polymorphic_allocator<T>;
+
+  template <typename T>
+  using ArenaVector = std::pmr::vector<T>;
+
+}
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <limits>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "reference_testing/binary_serializer.h"
+#include "reference_testing/reference_container.h"
+#include "reference_testing/thread_pool.h"
+
+namespace lumos
+{
+
+    namespace detail
+    {
+        // Asks the kernel to start reading a whole file in the background.
+        // Failures are ignored, the actual read reports them.
+        inline void adviseWillNeed(const std::string &filename)
+        {
+            const int fd = ::open(filename.c_str(), O_RDONLY);
+            if (fd >= 0)
+            {
+                ::posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+                ::close(fd);
+            }
+        }
+    }
+
+    // A set of channels being loaded, consumable in completion order:
+    //
+    //   LoadBatch<double> batch = loader.loadAll<double>(filenames);
+    //   for (size_t i = batch.nextReady(); i != LoadBatch<double>::kDone; i = batch.nextReady())
+    //   {
+    //       check(filenames[i], batch.get(i));
+    //   }
+    template <typename T>
+    class LoadBatch
+    {
+    public:
+        static constexpr size_t kDone = std::numeric_limits<size_t>::max();
+
+        size_t size() const
+        {
+            return futures_.size();
+        }
+
+        const std::shared_future<std::vector<T>> &future(size_t index) const
+        {
+            return futures_[index];
+        }
+
+        // Blocks until channel `index` has arrived, rethrows load errors
+        const std::vector<T> &get(size_t index) const
+        {
+            return futures_[index].get();
+        }
+
+        // Index of the next channel that has arrived and was not returned
+        // before, blocking until one arrives; kDone once all were returned
+        size_t nextReady()
+        {
+            if (consumed_ == futures_.size())
+            {
+                return kDone;
+            }
+
+            std::unique_lock<std::mutex> lock(completion_->mutex);
+            completion_->arrived.wait(lock, [&]
+                                      { return !completion_->ready.empty(); });
+            const size_t index = completion_->ready.front();
+            completion_->ready.pop_front();
+            consumed_++;
+            return index;
+        }
+
+    private:
+        friend class AsyncReferenceLoader;
+
+        struct Completion
+        {
+            std::mutex mutex;
+            std::condition_variable arrived;
+            std::deque<size_t> ready;
+
+            void push(size_t index)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    ready.push_back(index);
+                }
+                arrived.notify_all();
+            }
+        };
+
+        LoadBatch() : completion_(std::make_shared<Completion>()), consumed_(0) {}
+
+        std::vector<std::shared_future<std::vector<T>>> futures_;
+        std::shared_ptr<Completion> completion_;
+        size_t consumed_;
+    };
+
+    // Loads reference channels in the background on a pool of I/O threads so
+    // checks can start on the channels that have already arrived. Read-ahead
+    // is requested for every file as soon as it is queued, so the kernel keeps
+    // the disk busy even while all I/O threads wait on earlier files.
+    //
+    // Reads go through the thread pool; an io_uring backend would slot in
+    // behind the same interface.
+    class AsyncReferenceLoader
+    {
+    public:
+        static constexpr size_t kDefaultIoThreads = 8;
+
+        explicit AsyncReferenceLoader(size_t io_threads = kDefaultIoThreads) : pool_(io_threads) {}
+
+        // Loads a file written by saveBinaryVector
+        template <typename T>
+        std::shared_future<std::vector<T>> loadAsync(const std::string &filename)
+        {
+            detail::adviseWillNeed(filename);
+            return pool_.submit([filename]
+                                { return loadBinaryVector<T>(filename); })
+                .share();
+        }
+
+        // Copies a channel out of a container, which must outlive the load
+        template <typename T>
+        std::shared_future<std::vector<T>> loadAsync(const ReferenceContainer &container, const std::string &name)
+        {
+            const ContainerChannel &entry = container.channel(name);
+            adviseChannel(container, entry);
+            return pool_.submit([&container, name]
+                                { return container.load<T>(name); })
+                .share();
+        }
+
+        template <typename T>
+        LoadBatch<T> loadAll(const std::vector<std::string> &filenames)
+        {
+            for (const std::string &filename : filenames)
+            {
+                detail::adviseWillNeed(filename);
+            }
+
+            LoadBatch<T> batch;
+            for (size_t i = 0; i < filenames.size(); ++i)
+            {
+                batch.futures_.push_back(track<T>(batch, i, [filename = filenames[i]]
+                                                  { return loadBinaryVector<T>(filename); }));
+            }
+            return batch;
+        }
+
+        template <typename T>
+        LoadBatch<T> loadAll(const ReferenceContainer &container, const std::vector<std::string> &names)
+        {
+            for (const std::string &name : names)
+            {
+                adviseChannel(container, container.channel(name));
+            }
+
+            LoadBatch<T> batch;
+            for (size_t i = 0; i < names.size(); ++i)
+            {
+                batch.futures_.push_back(track<T>(batch, i, [&container, name = names[i]]
+                                                  { return container.load<T>(name); }));
+            }
+            return batch;
+        }
+
+    private:
+        template <typename T, typename Load>
+        std::shared_future<std::vector<T>> track(LoadBatch<T> &batch, size_t index, Load load)
+        {
+            auto completion = batch.completion_;
+            auto promise = std::make_shared<std::promise<std::vector<T>>>();
+            std::shared_future<std::vector<T>> future = promise->get_future().share();
+
+            pool_.submit([promise, completion, index, load]
+                         {
+                             try
+                             {
+                                 promise->set_value(load());
+                             }
+                             catch (...)
+                             {
+                                 promise->set_exception(std::current_exception());
+                             }
+                             completion->push(index); });
+            return future;
+        }
+
+        static void adviseChannel(const ReferenceContainer &container, const ContainerChannel &entry)
+        {
+            if (entry.payload_size == 0)
+            {
+                return;
+            }
+
+            // madvise needs a page-aligned start
+            const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+            const uintptr_t begin = reinterpret_cast<uintptr_t>(container.payload(entry));
+            const uintptr_t aligned = begin - begin % page;
+            ::madvise(reinterpret_cast<void *>(aligned), entry.payload_size + (begin - aligned), MADV_WILLNEED);
+        }
+
+        ThreadPool pool_;
+    };
+
+}
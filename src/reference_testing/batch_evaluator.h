@@ -0,0 +1,74 @@
+#pragma once
+
+#include <vector>
+#include <type_traits>
+
+#include "reference_testing/ranges.h"
+#include "reference_testing/check_set.h"
+#include "reference_testing/thread_pool.h"
+
+namespace lumos
+{
+
+  template <typename T>
+  struct RunResult
+  {
+    // True when every check of the run passed
+    bool passed;
+    std::vector<CheckResult<T>> checks;
+  };
+
+  // Evaluates one CheckSet against many test runs in parallel. Runs are
+  // sharded over the pool's workers; the reference and the bound ranges held
+  // by the CheckSet are shared read-only between them, and every run writes
+  // only its own result slot, so workers do not contend on shared state.
+  //
+  //   ThreadPool pool;
+  //   BatchEvaluator<double> batch(checks, pool);
+  //   std::vector<RunResult<double>> results = batch.evaluate(runs, reference);
+  template <typename T>
+  class BatchEvaluator
+  {
+  public:
+    BatchEvaluator(const CheckSet<T> &checks, ThreadPool &pool) : checks_(checks), pool_(pool) {}
+
+    template <typename TestRange, typename ReferenceRange>
+    std::vector<RunResult<T>> evaluate(const std::vector<TestRange> &runs, const ReferenceRange &reference) const
+    {
+      static_assert(std::is_same_v<T, RangeValueType<TestRange>> &&
+                        std::is_same_v<T, RangeValueType<ReferenceRange>>,
+                    "BatchEvaluator::evaluate requires test and reference ranges of the evaluator's value type");
+
+      std::vector<RunResult<T>> results(runs.size());
+      pool_.parallelFor(runs.size(), [&](size_t run)
+                        {
+                          RunResult<T> &result = results[run];
+                          result.checks = checks_.evaluate(runs[run], reference);
+                          result.passed = true;
+                          for (const CheckResult<T> &check : result.checks)
+                          {
+                            result.passed = result.passed && check.passed;
+                          } });
+      return results;
+    }
+
+  private:
+    CheckSet<T> checks_;
+    ThreadPool &pool_;
+  };
+
+  // Per-run verdicts of an arbitrary check, e.g. a corridor check of 2D runs:
+  //
+  //   std::vector<bool> verdicts = evaluateRuns(pool, runs_x.size(), [&](size_t run)
+  //                                             { return isWithin2DCorridor(runs_x[run], runs_y[run], corridor); });
+  template <typename Check>
+  std::vector<bool> evaluateRuns(ThreadPool &pool, size_t run_count, Check check)
+  {
+    // One byte per run; std::vector<bool> packs bits and cannot be written concurrently
+    std::vector<unsigned char> verdicts(run_count, 0);
+    pool.parallelFor(run_count, [&](size_t run)
+                     { verdicts[run] = check(run) ? 1 : 0; });
+    return std::vector<bool>(verdicts.begin(), verdicts.end());
+  }
+
+}
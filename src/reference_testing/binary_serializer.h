@@ -2,38 +2,123 @@
 
 #include <vector>
 #include <fstream>
+#include <string>
+#include <typeinfo>
 #include <type_traits>
 #include <stdexcept>
 #include <cstring>
+#include <algorithm>
+#include <memory>
 
 namespace lumos
 {
 
+    // Payloads start at a multiple of this many bytes from the beginning of
+    // the file, so memory-mapped data is suitably aligned for any T and SIMD.
+    // The padding is stored as trailing NULs of the type name, which keeps the
+    // layout readable by loaders that only compare the NUL-terminated name.
+    constexpr size_t kBinaryPayloadAlignment = 64;
+
+    struct BinaryHeader
+    {
+        size_t element_count;
+        size_t payload_offset;
+    };
+
     template <typename T>
-    void saveBinaryVector(const std::vector<T> &data, const std::string &filename)
+    BinaryHeader readBinaryHeader(std::istream &file, const std::string &filename)
     {
         static_assert(std::is_trivially_copyable_v<T>,
-                      "Type T must be trivially copyable for binary serialization");
+                      "Type T must be trivially copyable for binary deserialization");
 
-        std::ofstream file(filename, std::ios::binary);
-        if (!file.is_open())
+        // Read and verify type information
+        size_t type_name_length = 0;
+        file.read(reinterpret_cast<char *>(&type_name_length), sizeof(type_name_length));
+        if (!file.good())
         {
-            throw std::runtime_error("Failed to open file for writing: " + filename);
+            throw std::runtime_error("Error reading from file: " + filename);
+        }
+
+        // Names of the padded length fit on the stack, so loading allocates
+        // nothing beyond the result
+        char small_type_name[128];
+        std::vector<char> large_type_name;
+        char *stored_type_name = small_type_name;
+        if (type_name_length >= sizeof(small_type_name))
+        {
+            large_type_name.resize(type_name_length + 1);
+            stored_type_name = large_type_name.data();
+        }
+        file.read(stored_type_name, type_name_length);
+        stored_type_name[file.good() ? type_name_length : 0] = '\0';
+
+        if (std::strcmp(stored_type_name, typeid(T).name()) != 0)
+        {
+            throw std::runtime_error("Type mismatch: file contains " +
+                                     std::string(stored_type_name) +
+                                     ", requested " + std::string(typeid(T).name()));
+        }
+
+        // Read and verify element size
+        size_t stored_element_size;
+        file.read(reinterpret_cast<char *>(&stored_element_size), sizeof(stored_element_size));
+
+        if (stored_element_size != sizeof(T))
+        {
+            throw std::runtime_error("Element size mismatch");
+        }
+
+        // Read vector size
+        size_t vector_size;
+        file.read(reinterpret_cast<char *>(&vector_size), sizeof(vector_size));
+
+        if (!file.good())
+        {
+            throw std::runtime_error("Error reading from file: " + filename);
         }
 
-        // Write type information
+        return {vector_size, 3 * sizeof(size_t) + type_name_length};
+    }
+
+    template <typename T>
+    void writeBinaryHeader(std::ostream &file, size_t vector_size)
+    {
+        // Write type information, NUL-padded so the payload is aligned
         const char *type_name = typeid(T).name();
-        size_t type_name_length = std::strlen(type_name);
+        const size_t name_length = std::strlen(type_name);
+        const size_t unpadded_size = 3 * sizeof(size_t) + name_length;
+        const size_t padding = (kBinaryPayloadAlignment - unpadded_size % kBinaryPayloadAlignment) %
+                               kBinaryPayloadAlignment;
+        size_t type_name_length = name_length + padding;
         file.write(reinterpret_cast<const char *>(&type_name_length), sizeof(type_name_length));
-        file.write(type_name, type_name_length);
+        file.write(type_name, name_length);
+        for (size_t i = 0; i < padding; ++i)
+        {
+            file.put('\0');
+        }
 
         // Write element size
         size_t element_size = sizeof(T);
         file.write(reinterpret_cast<const char *>(&element_size), sizeof(element_size));
 
         // Write vector size
-        size_t vector_size = data.size();
         file.write(reinterpret_cast<const char *>(&vector_size), sizeof(vector_size));
+    }
+
+    template <typename T, typename Allocator>
+    void saveBinaryVector(const std::vector<T, Allocator> &data, const std::string &filename)
+    {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "Type T must be trivially copyable for binary serialization");
+
+        std::ofstream file(filename, std::ios::binary);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Failed to open file for writing: " + filename);
+        }
+
+        size_t vector_size = data.size();
+        writeBinaryHeader<T>(file, vector_size);
 
         // Write vector data
         if (!data.empty())
@@ -47,50 +132,67 @@ namespace lumos
         }
     }
 
-    template <typename T>
-    std::vector<T> loadBinaryVector(const std::string &filename)
+    // The result is allocated with allocator, e.g. an ArenaAllocator<T>. The
+    // stream buffers the header on the stack and reads the payload directly,
+    // so nothing else is allocated.
+    template <typename T, typename Allocator = std::allocator<T>>
+    std::vector<T, Allocator> loadBinaryVector(const std::string &filename, const Allocator &allocator = Allocator())
     {
         static_assert(std::is_trivially_copyable_v<T>,
                       "Type T must be trivially copyable for binary deserialization");
 
-        std::ifstream file(filename, std::ios::binary);
+        char stream_buffer[256];
+        std::ifstream file;
+        file.rdbuf()->pubsetbuf(stream_buffer, sizeof(stream_buffer));
+        file.open(filename, std::ios::binary);
         if (!file.is_open())
         {
             throw std::runtime_error("Failed to open file for reading: " + filename);
         }
 
-        // Read and verify type information
-        size_t type_name_length;
-        file.read(reinterpret_cast<char *>(&type_name_length), sizeof(type_name_length));
+        const BinaryHeader header = readBinaryHeader<T>(file, filename);
+        size_t vector_size = header.element_count;
 
-        std::vector<char> stored_type_name(type_name_length + 1, '\0');
-        file.read(stored_type_name.data(), type_name_length);
+        // Read vector data
+        std::vector<T, Allocator> result(vector_size, allocator);
+        if (vector_size > 0)
+        {
+            file.read(reinterpret_cast<char *>(result.data()), vector_size * sizeof(T));
+        }
 
-        if (std::strcmp(stored_type_name.data(), typeid(T).name()) != 0)
+        if (!file.good())
         {
-            throw std::runtime_error("Type mismatch: file contains " +
-                                     std::string(stored_type_name.data()) +
-                                     ", requested " + std::string(typeid(T).name()));
+            throw std::runtime_error("Error reading from file: " + filename);
         }
 
-        // Read and verify element size
-        size_t stored_element_size;
-        file.read(reinterpret_cast<char *>(&stored_element_size), sizeof(stored_element_size));
+        return result;
+    }
 
-        if (stored_element_size != sizeof(T))
+    // Reads elements [begin, end) of a vector saved with saveBinaryVector,
+    // seeking past the rest so only the window is read from disk
+    template <typename T>
+    std::vector<T> loadBinaryVectorSlice(const std::string &filename, size_t begin, size_t end)
+    {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "Type T must be trivially copyable for binary deserialization");
+
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open())
         {
-            throw std::runtime_error("Element size mismatch");
+            throw std::runtime_error("Failed to open file for reading: " + filename);
         }
 
-        // Read vector size
-        size_t vector_size;
-        file.read(reinterpret_cast<char *>(&vector_size), sizeof(vector_size));
+        const BinaryHeader header = readBinaryHeader<T>(file, filename);
+        if (begin > end || end > header.element_count)
+        {
+            throw std::invalid_argument("Slice range exceeds the vector size");
+        }
 
-        // Read vector data
-        std::vector<T> result(vector_size);
-        if (vector_size > 0)
+        std::vector<T> result(end - begin);
+        if (!result.empty())
         {
-            file.read(reinterpret_cast<char *>(result.data()), vector_size * sizeof(T));
+            file.seekg(static_cast<std::streamoff>(header.payload_offset + begin * sizeof(T)));
+            file.read(reinterpret_cast<char *>(result.data()), result.size() * sizeof(T));
         }
 
         if (!file.good())
@@ -101,4 +203,178 @@ namespace lumos
         return result;
     }
 
+    // Writes a binary vector file incrementally. Chunks are appended as they
+    // are produced and the element count in the header is patched on close(),
+    // so recordings never need to be resident in memory as a whole.
+    template <typename T>
+    class BinaryVectorWriter
+    {
+    public:
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "Type T must be trivially copyable for binary serialization");
+
+        explicit BinaryVectorWriter(const std::string &filename)
+            : filename_(filename), file_(filename, std::ios::binary), element_count_(0)
+        {
+            if (!file_.is_open())
+            {
+                throw std::runtime_error("Failed to open file for writing: " + filename);
+            }
+
+            writeBinaryHeader<T>(file_, 0);
+            count_offset_ = static_cast<std::streamoff>(file_.tellp()) - static_cast<std::streamoff>(sizeof(size_t));
+        }
+
+        ~BinaryVectorWriter()
+        {
+            try
+            {
+                close();
+            }
+            catch (...)
+            {
+            }
+        }
+
+        BinaryVectorWriter(const BinaryVectorWriter &) = delete;
+        BinaryVectorWriter &operator=(const BinaryVectorWriter &) = delete;
+
+        void append(const T *data, size_t count)
+        {
+            if (!file_.is_open())
+            {
+                throw std::runtime_error("Writer already closed: " + filename_);
+            }
+
+            if (count > 0)
+            {
+                file_.write(reinterpret_cast<const char *>(data), count * sizeof(T));
+                element_count_ += count;
+            }
+
+            if (!file_.good())
+            {
+                throw std::runtime_error("Error writing to file: " + filename_);
+            }
+        }
+
+        void append(const std::vector<T> &chunk)
+        {
+            append(chunk.data(), chunk.size());
+        }
+
+        void append(const T &value)
+        {
+            append(&value, 1);
+        }
+
+        size_t size() const
+        {
+            return element_count_;
+        }
+
+        void close()
+        {
+            if (!file_.is_open())
+            {
+                return;
+            }
+
+            file_.seekp(count_offset_);
+            file_.write(reinterpret_cast<const char *>(&element_count_), sizeof(element_count_));
+            const bool good = file_.good();
+            file_.close();
+
+            if (!good)
+            {
+                throw std::runtime_error("Error writing to file: " + filename_);
+            }
+        }
+
+    private:
+        std::string filename_;
+        std::ofstream file_;
+        std::streamoff count_offset_;
+        size_t element_count_;
+    };
+
+    // Reads a binary vector file in fixed-size chunks so only chunk_size
+    // elements are resident at a time.
+    //
+    //   BinaryVectorReader<double> reader("x.bin", 4096);
+    //   while (reader.next())
+    //   {
+    //       process(reader.chunk());
+    //   }
+    template <typename T>
+    class BinaryVectorReader
+    {
+    public:
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "Type T must be trivially copyable for binary deserialization");
+
+        BinaryVectorReader(const std::string &filename, size_t chunk_size)
+            : filename_(filename), file_(filename, std::ios::binary), chunk_size_(chunk_size), position_(0)
+        {
+            if (chunk_size == 0)
+            {
+                throw std::invalid_argument("Chunk size must be non-zero");
+            }
+
+            if (!file_.is_open())
+            {
+                throw std::runtime_error("Failed to open file for reading: " + filename);
+            }
+
+            element_count_ = readBinaryHeader<T>(file_, filename).element_count;
+            chunk_.reserve(std::min(chunk_size_, element_count_));
+        }
+
+        // Reads the next chunk, returns false once all elements were read
+        bool next()
+        {
+            const size_t count = std::min(chunk_size_, element_count_ - position_);
+            chunk_.resize(count);
+            if (count == 0)
+            {
+                return false;
+            }
+
+            file_.read(reinterpret_cast<char *>(chunk_.data()), count * sizeof(T));
+            if (!file_.good())
+            {
+                throw std::runtime_error("Error reading from file: " + filename_);
+            }
+
+            chunk_offset_ = position_;
+            position_ += count;
+            return true;
+        }
+
+        const std::vector<T> &chunk() const
+        {
+            return chunk_;
+        }
+
+        // Index of the first element of the current chunk
+        size_t chunkOffset() const
+        {
+            return chunk_offset_;
+        }
+
+        size_t size() const
+        {
+            return element_count_;
+        }
+
+    private:
+        std::string filename_;
+        std::ifstream file_;
+        size_t chunk_size_;
+        size_t element_count_;
+        size_t position_;
+        size_t chunk_offset_ = 0;
+        std::vector<T> chunk_;
+    };
+
 }
@@ -6,81 +6,141 @@
 #include <numeric>
 #include <cmath>
 #include <functional>
+#include <algorithm>
 
 #include <duoplot/duoplot.h>
+
+#include "reference_testing/ranges.h"
+#include "reference_testing/interpolation.h"
+#include "reference_testing/simd_kernels.h"
+#include "reference_testing/corridor.h"
+
 namespace lumos
 {
 
-  template <typename T>
-  T linearInterpolate(T x, T x0, T y0, T x1, T y1)
-  {
-    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
-                  "linearInterpolate only supports float and double types");
-    if (x1 == x0)
-      return y0;
-    return y0 + (y1 - y0) * (x - x0) / (x1 - x0);
-  }
-
-  template <typename T>
-  T interpolateAtTime(T target_time,
-                      const std::vector<T> &time_vec,
-                      const std::vector<T> &value_vec)
+  template <typename TestRange, typename BoundRange>
+  bool isWithinBounds(const TestRange &test_vector,
+                      const BoundRange &min_bounds,
+                      const BoundRange &max_bounds)
   {
+    using T = RangeValueType<TestRange>;
+    static_assert(std::is_same_v<T, RangeValueType<BoundRange>>,
+                  "isWithinBounds requires test and bound ranges of the same value type");
     static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
-                  "interpolateAtTime only supports float and double types");
-    if (time_vec.size() != value_vec.size() || time_vec.empty())
+                  "isWithinBounds only supports float and double types");
+    if (test_vector.size() != min_bounds.size() || test_vector.size() != max_bounds.size())
     {
-      throw std::invalid_argument("Time and value vectors must have same non-zero size");
+      return false;
     }
 
-    if (target_time <= time_vec[0])
-      return value_vec[0];
-    if (target_time >= time_vec.back())
-      return value_vec.back();
-
-    for (size_t i = 0; i < time_vec.size() - 1; ++i)
+    if constexpr (IsContiguousRange<TestRange>::value && IsContiguousRange<BoundRange>::value)
+    {
+      return findFirstOutsideBounds(test_vector.data(), min_bounds.data(), max_bounds.data(),
+                                    test_vector.size()) == test_vector.size();
+    }
+    else
     {
-      if (target_time >= time_vec[i] && target_time <= time_vec[i + 1])
+      for (size_t i = 0; i < test_vector.size(); ++i)
       {
-        return linearInterpolate(target_time, time_vec[i], value_vec[i],
-                                 time_vec[i + 1], value_vec[i + 1]);
+        if (test_vector[i] < min_bounds[i] || test_vector[i] > max_bounds[i])
+        {
+          return false;
+        }
       }
-    }
 
-    return value_vec.back();
+      return true;
+    }
   }
 
-  template <typename T>
-  bool isWithinBounds(const std::vector<T> &test_vector,
-                      const std::vector<T> &min_bounds,
-                      const std::vector<T> &max_bounds)
+  namespace detail
   {
-    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
-                  "isWithinBounds only supports float and double types");
-    if (test_vector.size() != min_bounds.size() || test_vector.size() != max_bounds.size())
+    // Walks the test samples with the bounds interpolated at their times and
+    // calls visit(index, test_value, min_bound, max_bound) until it returns
+    // false. bounds_sorted tells whether both bound timebases are sorted.
+    // Returns false if the walk was stopped.
+    template <typename TestRange, typename BoundRange, typename Visitor>
+    bool visitTimeBounds(const TestRange &test_vector_time,
+                         const TestRange &test_vector,
+                         const BoundRange &min_bounds_time,
+                         const BoundRange &min_bounds,
+                         const BoundRange &max_bounds_time,
+                         const BoundRange &max_bounds,
+                         bool bounds_sorted,
+                         Visitor visit)
     {
-      return false;
-    }
+      using T = RangeValueType<TestRange>;
 
-    for (size_t i = 0; i < test_vector.size(); ++i)
-    {
-      if (test_vector[i] < min_bounds[i] || test_vector[i] > max_bounds[i])
+      // Unsorted bound timebases cannot be walked with a cursor, keep the
+      // original per-sample scan for them
+      if (!bounds_sorted)
       {
-        return false;
+        for (size_t i = 0; i < test_vector.size(); ++i)
+        {
+          T time = test_vector_time[i];
+
+          T min_bound = interpolateAtTime(time, min_bounds_time, min_bounds);
+          T max_bound = interpolateAtTime(time, max_bounds_time, max_bounds);
+
+          if (!visit(i, test_vector[i], min_bound, max_bound))
+          {
+            return false;
+          }
+        }
+
+        return true;
       }
+
+      // Contiguous bounds are walked through pointers, other ranges such as
+      // StridedSpan are cheap views and are held as they are
+      using View = std::conditional_t<IsContiguousRange<BoundRange>::value, Span<const T>, BoundRange>;
+      Interpolator<T, View> min_interpolator(min_bounds_time, min_bounds);
+      Interpolator<T, View> max_interpolator(max_bounds_time, max_bounds);
+
+      for (size_t i = 0; i < test_vector.size(); ++i)
+      {
+        T time = test_vector_time[i];
+
+        T min_bound = min_interpolator(time);
+        T max_bound = max_interpolator(time);
+
+        if (!visit(i, test_vector[i], min_bound, max_bound))
+        {
+          return false;
+        }
+      }
+
+      return true;
     }
 
-    return true;
+    // Time-based bounds check after size validation
+    template <typename TestRange, typename BoundRange>
+    bool isWithinTimeBounds(const TestRange &test_vector_time,
+                            const TestRange &test_vector,
+                            const BoundRange &min_bounds_time,
+                            const BoundRange &min_bounds,
+                            const BoundRange &max_bounds_time,
+                            const BoundRange &max_bounds,
+                            bool bounds_sorted)
+    {
+      using T = RangeValueType<TestRange>;
+      return visitTimeBounds(test_vector_time, test_vector, min_bounds_time, min_bounds,
+                             max_bounds_time, max_bounds, bounds_sorted,
+                             [](size_t, T test_value, T min_bound, T max_bound)
+                             { return !(test_value < min_bound || test_value > max_bound); });
+    }
   }
 
-  template <typename T>
-  bool isWithinBounds(const std::vector<T> &test_vector_time,
-                      const std::vector<T> &test_vector,
-                      const std::vector<T> &min_bounds_time,
-                      const std::vector<T> &min_bounds,
-                      const std::vector<T> &max_bounds_time,
-                      const std::vector<T> &max_bounds)
+  template <typename TestRange, typename BoundRange>
+  bool isWithinBounds(const TestRange &test_vector_time,
+                      const TestRange &test_vector,
+                      const BoundRange &min_bounds_time,
+                      const BoundRange &min_bounds,
+                      const BoundRange &max_bounds_time,
+                      const BoundRange &max_bounds)
   {
+    using T = RangeValueType<TestRange>;
+    static_assert(std::is_same_v<T, RangeValueType<BoundRange>>,
+                  "isWithinBounds requires test and bound ranges of the same value type");
     static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
                   "isWithinBounds only supports float and double types");
     if (test_vector_time.size() != test_vector.size())
@@ -94,28 +154,94 @@ namespace lumos
       return false;
     }
 
-    for (size_t i = 0; i < test_vector.size(); ++i)
+    if (test_vector.empty())
     {
-      T time = test_vector_time[i];
-      T test_value = test_vector[i];
+      return true;
+    }
 
-      T min_bound = interpolateAtTime(time, min_bounds_time, min_bounds);
-      T max_bound = interpolateAtTime(time, max_bounds_time, max_bounds);
+    return detail::isWithinTimeBounds(test_vector_time, test_vector,
+                                      min_bounds_time, min_bounds,
+                                      max_bounds_time, max_bounds,
+                                      isSortedTimeVector(min_bounds_time) && isSortedTimeVector(max_bounds_time));
+  }
 
-      if (test_value < min_bound || test_value > max_bound)
+  namespace detail
+  {
+    // Variance of the test relative to the reference for equally sized,
+    // non-empty ranges. Contiguous data uses the SIMD kernel, other ranges
+    // the same fixed reduction order.
+    template <typename TestRange, typename ReferenceRange>
+    RangeValueType<TestRange> differenceVariance(const TestRange &test_vector, const ReferenceRange &reference_vector)
+    {
+      using T = RangeValueType<TestRange>;
+      T sum_squared_diff = T(0);
+      if constexpr (IsContiguousRange<TestRange>::value && IsContiguousRange<ReferenceRange>::value)
       {
-        return false;
+        sum_squared_diff = sumSquaredDifference(test_vector.data(), reference_vector.data(), test_vector.size());
       }
+      else
+      {
+        sum_squared_diff = sumSquaredDifferenceIndexed<T>(test_vector, reference_vector, test_vector.size());
+      }
+      return sum_squared_diff / static_cast<T>(test_vector.size());
+    }
+
+    // Absolute difference of the means of two non-empty ranges
+    template <typename TestRange, typename ReferenceRange>
+    RangeValueType<TestRange> meanDifference(const TestRange &test_vector, const ReferenceRange &reference_vector)
+    {
+      using T = RangeValueType<TestRange>;
+      T test_mean = std::accumulate(test_vector.begin(), test_vector.end(), T(0)) /
+                    static_cast<T>(test_vector.size());
+      T ref_mean = std::accumulate(reference_vector.begin(), reference_vector.end(), T(0)) /
+                   static_cast<T>(reference_vector.size());
+      return std::abs(test_mean - ref_mean);
     }
 
-    return true;
+    // Counts samples above (or below) the threshold. Contiguous data is
+    // counted block-wise and the scan stops once min_samples is reached;
+    // samples_scanned tells how far it got.
+    template <bool Above, typename Range>
+    size_t countPastThreshold(const Range &test_vector, RangeValueType<Range> threshold, size_t min_samples,
+                              size_t &samples_scanned)
+    {
+      using T = RangeValueType<Range>;
+      const size_t n = test_vector.size();
+      size_t count = 0;
+      if constexpr (IsContiguousRange<Range>::value)
+      {
+        size_t start = 0;
+        for (; start < n && count < min_samples; start += kKernelBlockSize)
+        {
+          const size_t block = std::min(kKernelBlockSize, n - start);
+          count += Above ? countAboveThreshold(test_vector.data() + start, block, threshold)
+                         : countBelowThreshold(test_vector.data() + start, block, threshold);
+        }
+        samples_scanned = std::min(start, n);
+      }
+      else
+      {
+        for (const T &value : test_vector)
+        {
+          if (Above ? value > threshold : value < threshold)
+          {
+            count++;
+          }
+        }
+        samples_scanned = n;
+      }
+      return count;
+    }
   }
 
-  template <typename T>
-  bool isVarianceWithinThreshold(const std::vector<T> &test_vector,
-                                 const std::vector<T> &reference_vector,
-                                 T threshold)
+  template <typename TestRange, typename ReferenceRange>
+  bool isVarianceWithinThreshold(const TestRange &test_vector,
+                                 const ReferenceRange &reference_vector,
+                                 RangeValueType<TestRange> threshold)
   {
+    using T = RangeValueType<TestRange>;
+    static_assert(std::is_same_v<T, RangeValueType<ReferenceRange>>,
+                  "isVarianceWithinThreshold requires test and reference ranges of the same value type");
     static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
                   "isVarianceWithinThreshold only supports float and double types");
 
@@ -129,23 +255,18 @@ namespace lumos
       return true;
     }
 
-    // Calculate variance of test vector relative to reference
-    T sum_squared_diff = T(0);
-    for (size_t i = 0; i < test_vector.size(); ++i)
-    {
-      T diff = test_vector[i] - reference_vector[i];
-      sum_squared_diff += diff * diff;
-    }
-
-    T variance = sum_squared_diff / static_cast<T>(test_vector.size());
+    T variance = detail::differenceVariance(test_vector, reference_vector);
     return variance <= threshold;
   }
 
-  template <typename T>
-  bool isMeanDifferenceWithinThreshold(const std::vector<T> &test_vector,
-                                       const std::vector<T> &reference_vector,
-                                       T threshold)
+  template <typename TestRange, typename ReferenceRange>
+  bool isMeanDifferenceWithinThreshold(const TestRange &test_vector,
+                                       const ReferenceRange &reference_vector,
+                                       RangeValueType<TestRange> threshold)
   {
+    using T = RangeValueType<TestRange>;
+    static_assert(std::is_same_v<T, RangeValueType<ReferenceRange>>,
+                  "isMeanDifferenceWithinThreshold requires test and reference ranges of the same value type");
     static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
                   "isMeanDifferenceWithinThreshold only supports float and double types");
 
@@ -159,40 +280,29 @@ namespace lumos
       return true;
     }
 
-    T test_mean = std::accumulate(test_vector.begin(), test_vector.end(), T(0)) /
-                  static_cast<T>(test_vector.size());
-    T ref_mean = std::accumulate(reference_vector.begin(), reference_vector.end(), T(0)) /
-                 static_cast<T>(reference_vector.size());
-
-    T mean_diff = std::abs(test_mean - ref_mean);
+    T mean_diff = detail::meanDifference(test_vector, reference_vector);
     return mean_diff <= threshold;
   }
 
-  template <typename T>
-  bool hasAtLeastNSamplesAboveThreshold(const std::vector<T> &test_vector,
-                                        T threshold,
+  template <typename Range>
+  bool hasAtLeastNSamplesAboveThreshold(const Range &test_vector,
+                                        RangeValueType<Range> threshold,
                                         size_t min_samples)
   {
+    using T = RangeValueType<Range>;
     static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
                   "hasAtLeastNSamplesAboveThreshold only supports float and double types");
 
-    size_t count = 0;
-    for (const T &value : test_vector)
-    {
-      if (value > threshold)
-      {
-        count++;
-      }
-    }
-
-    return count >= min_samples;
+    size_t samples_scanned = 0;
+    return detail::countPastThreshold<true>(test_vector, threshold, min_samples, samples_scanned) >= min_samples;
   }
 
-  template <typename T>
-  bool hasAtLeastNConsecutiveSamplesAboveThreshold(const std::vector<T> &test_vector,
-                                                   T threshold,
+  template <typename Range>
+  bool hasAtLeastNConsecutiveSamplesAboveThreshold(const Range &test_vector,
+                                                   RangeValueType<Range> threshold,
                                                    size_t min_consecutive)
   {
+    using T = RangeValueType<Range>;
     static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
                   "hasAtLeastNConsecutiveSamplesAboveThreshold only supports float and double types");
 
@@ -221,31 +331,25 @@ namespace lumos
     return false;
   }
 
-  template <typename T>
-  bool hasAtLeastNSamplesBelowThreshold(const std::vector<T> &test_vector,
-                                        T threshold,
+  template <typename Range>
+  bool hasAtLeastNSamplesBelowThreshold(const Range &test_vector,
+                                        RangeValueType<Range> threshold,
                                         size_t min_samples)
   {
+    using T = RangeValueType<Range>;
     static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
                   "hasAtLeastNSamplesBelowThreshold only supports float and double types");
 
-    size_t count = 0;
-    for (const T &value : test_vector)
-    {
-      if (value < threshold)
-      {
-        count++;
-      }
-    }
-
-    return count >= min_samples;
+    size_t samples_scanned = 0;
+    return detail::countPastThreshold<false>(test_vector, threshold, min_samples, samples_scanned) >= min_samples;
   }
 
-  template <typename T>
-  bool hasAtLeastNConsecutiveSamplesBelowThreshold(const std::vector<T> &test_vector,
-                                                   T threshold,
+  template <typename Range>
+  bool hasAtLeastNConsecutiveSamplesBelowThreshold(const Range &test_vector,
+                                                   RangeValueType<Range> threshold,
                                                    size_t min_consecutive)
   {
+    using T = RangeValueType<Range>;
     static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
                   "hasAtLeastNConsecutiveSamplesBelowThreshold only supports float and double types");
 
@@ -274,11 +378,12 @@ namespace lumos
     return false;
   }
 
-  template <typename T, typename Predicate>
-  bool hasAtLeastNSamplesWithConditionTrue(const std::vector<T> &test_vector,
+  template <typename Range, typename Predicate>
+  bool hasAtLeastNSamplesWithConditionTrue(const Range &test_vector,
                                            Predicate condition,
                                            size_t min_samples)
   {
+    using T = RangeValueType<Range>;
     static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
                   "hasAtLeastNSamplesWithConditionTrue only supports float and double types");
 
@@ -294,11 +399,12 @@ namespace lumos
     return count >= min_samples;
   }
 
-  template <typename T, typename Predicate>
-  bool hasAtLeastNConsecutiveSamplesWithConditionTrue(const std::vector<T> &test_vector,
+  template <typename Range, typename Predicate>
+  bool hasAtLeastNConsecutiveSamplesWithConditionTrue(const Range &test_vector,
                                                       Predicate condition,
                                                       size_t min_consecutive)
   {
+    using T = RangeValueType<Range>;
     static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
                   "hasAtLeastNConsecutiveSamplesWithConditionTrue only supports float and double types");
 
@@ -327,12 +433,19 @@ namespace lumos
     return false;
   }
 
-  template <typename T>
+  // True if every test point lies in the corridor between the left and the
+  // right boundary polyline, see Corridor2D. Points on either boundary,
+  // including the left one, count as inside. Points left of the left
+  // boundary fail; the former segment-side test skipped them instead.
+  template <typename TestRange, typename BoundaryRange>
   bool isWithin2DCorridor(
-      const std::vector<T> &x_test, const std::vector<T> &y_test,
-      const std::vector<T> &x_left, const std::vector<T> &y_left,
-      const std::vector<T> &x_right, const std::vector<T> &y_right)
+      const TestRange &x_test, const TestRange &y_test,
+      const BoundaryRange &x_left, const BoundaryRange &y_left,
+      const BoundaryRange &x_right, const BoundaryRange &y_right)
   {
+    using T = RangeValueType<TestRange>;
+    static_assert(std::is_same_v<T, RangeValueType<BoundaryRange>>,
+                  "isWithin2DCorridor requires test and boundary ranges of the same value type");
     static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
                   "isWithin2DCorridor only supports float and double types");
 
@@ -341,61 +454,10 @@ namespace lumos
       throw std::invalid_argument("Test vectors must have the same size");
     }
 
-    if (x_left.size() != y_left.size() || x_right.size() != y_right.size())
-    {
-      throw std::invalid_argument("Boundary vectors must have consistent sizes");
-    }
-
-    if (x_left.size() < 2 || x_right.size() < 2)
-    {
-      throw std::invalid_argument("Boundary vectors must have at least 2 points");
-    }
-
-    // Helper function to check if point is on the left side of a line segment
-    auto isPointOnLeftSide = [](T px, T py, T x1, T y1, T x2, T y2) -> bool
-    {
-      return ((x2 - x1) * (py - y1) - (y2 - y1) * (px - x1)) >= 0;
-    };
-
-    for (size_t i = 0; i < x_test.size(); ++i)
-    {
-      T test_x = x_test[i];
-      T test_y = y_test[i];
-      bool inside_corridor = true;
-
-      // Check if point is inside the corridor by verifying it's on the correct side
-      // of all left boundary segments and correct side of all right boundary segments
-
-      // Check left boundary - point should be on the right side of left boundary
-      for (size_t j = 0; j < x_left.size() - 1; ++j)
-      {
-        if (isPointOnLeftSide(test_x, test_y, x_left[j], y_left[j], x_left[j + 1], y_left[j + 1]))
-        {
-          inside_corridor = false;
-          break;
-        }
-      }
-
-      if (!inside_corridor)
-        continue;
-
-      // Check right boundary - point should be on the left side of right boundary
-      for (size_t j = 0; j < x_right.size() - 1; ++j)
-      {
-        if (!isPointOnLeftSide(test_x, test_y, x_right[j], y_right[j], x_right[j + 1], y_right[j + 1]))
-        {
-          inside_corridor = false;
-          break;
-        }
-      }
-
-      if (!inside_corridor)
-      {
-        return false;
-      }
-    }
-
-    return true;
+    // Build the indexed corridor once per call, construct a Corridor2D
+    // directly to reuse it across many trajectories
+    const Corridor2D<T> corridor(x_left, y_left, x_right, y_right);
+    return isWithin2DCorridor(x_test, y_test, corridor);
   }
 
 }
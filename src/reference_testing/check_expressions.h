@@ -0,0 +1,422 @@
+#pragma once
+
+#include <type_traits>
+#include <algorithm>
+#include <cstddef>
+
+#include "reference_testing/ranges.h"
+
+namespace lumos
+{
+
+  // Composable checks that are evaluated in one fused pass over the data.
+  // Sample predicates say something about a single sample, quantifiers turn
+  // a predicate into a verdict over the whole range, and both combine with
+  // &&, || and !:
+  //
+  //   bool passed = isSatisfied(x, all(within(x_min, x_max)) &&
+  //                                    any(above(0.4)) &&
+  //                                    runAtLeast(10, below(-0.45)));
+  //
+  // Every node is a plain template, so the expression is one concrete type
+  // and the loop in isSatisfied() is specialised for it at compile time,
+  // with no virtual calls or std::function. Quantifier state only ever
+  // moves one way, so the pass can stop once the verdict is decided.
+
+  namespace detail
+  {
+    template <typename Node, typename = void>
+    struct IsPredicateNode : std::false_type
+    {
+    };
+
+    template <typename Node>
+    struct IsPredicateNode<Node, std::void_t<decltype(std::decay_t<Node>::kIsSamplePredicate)>>
+        : std::bool_constant<std::decay_t<Node>::kIsSamplePredicate>
+    {
+    };
+
+    template <typename Node, typename = void>
+    struct IsQuantifierNode : std::false_type
+    {
+    };
+
+    template <typename Node>
+    struct IsQuantifierNode<Node, std::void_t<decltype(std::decay_t<Node>::kIsQuantifier)>>
+        : std::bool_constant<std::decay_t<Node>::kIsQuantifier>
+    {
+    };
+
+    // A bound given as a scalar or as one value per sample
+    template <typename Bound, bool = IsRange<Bound>::value>
+    struct BoundAccess
+    {
+      Bound value;
+
+      Bound operator[](size_t) const { return value; }
+      bool matchesSize(size_t) const { return true; }
+    };
+
+    template <typename Bound>
+    struct BoundAccess<Bound, true>
+    {
+      Span<const RangeValueType<Bound>> values;
+
+      RangeValueType<Bound> operator[](size_t index) const { return values[index]; }
+      bool matchesSize(size_t size) const { return values.size() == size; }
+    };
+  }
+
+  // Sample predicates
+
+  template <typename Threshold>
+  struct AbovePredicate
+  {
+    static constexpr bool kIsSamplePredicate = true;
+    Threshold threshold;
+
+    template <typename T>
+    bool operator()(T value, size_t) const { return value > threshold; }
+    bool matchesSize(size_t) const { return true; }
+  };
+
+  template <typename Threshold>
+  struct BelowPredicate
+  {
+    static constexpr bool kIsSamplePredicate = true;
+    Threshold threshold;
+
+    template <typename T>
+    bool operator()(T value, size_t) const { return value < threshold; }
+    bool matchesSize(size_t) const { return true; }
+  };
+
+  template <typename MinBound, typename MaxBound>
+  struct WithinPredicate
+  {
+    static constexpr bool kIsSamplePredicate = true;
+    detail::BoundAccess<MinBound> min_bound;
+    detail::BoundAccess<MaxBound> max_bound;
+
+    template <typename T>
+    bool operator()(T value, size_t index) const
+    {
+      return !(value < min_bound[index] || value > max_bound[index]);
+    }
+
+    bool matchesSize(size_t size) const { return min_bound.matchesSize(size) && max_bound.matchesSize(size); }
+  };
+
+  // Wraps a callable taking a sample, inlined like the built-in predicates
+  template <typename Function>
+  struct WherePredicate
+  {
+    static constexpr bool kIsSamplePredicate = true;
+    Function function;
+
+    template <typename T>
+    bool operator()(T value, size_t) const { return function(value); }
+    bool matchesSize(size_t) const { return true; }
+  };
+
+  template <typename Left, typename Right>
+  struct AndPredicate
+  {
+    static constexpr bool kIsSamplePredicate = true;
+    Left left;
+    Right right;
+
+    template <typename T>
+    bool operator()(T value, size_t index) const { return left(value, index) & right(value, index); }
+    bool matchesSize(size_t size) const { return left.matchesSize(size) && right.matchesSize(size); }
+  };
+
+  template <typename Left, typename Right>
+  struct OrPredicate
+  {
+    static constexpr bool kIsSamplePredicate = true;
+    Left left;
+    Right right;
+
+    template <typename T>
+    bool operator()(T value, size_t index) const { return left(value, index) | right(value, index); }
+    bool matchesSize(size_t size) const { return left.matchesSize(size) && right.matchesSize(size); }
+  };
+
+  template <typename Inner>
+  struct NotPredicate
+  {
+    static constexpr bool kIsSamplePredicate = true;
+    Inner inner;
+
+    template <typename T>
+    bool operator()(T value, size_t index) const { return !inner(value, index); }
+    bool matchesSize(size_t size) const { return inner.matchesSize(size); }
+  };
+
+  template <typename Threshold>
+  constexpr AbovePredicate<Threshold> above(Threshold threshold)
+  {
+    return {threshold};
+  }
+
+  template <typename Threshold>
+  constexpr BelowPredicate<Threshold> below(Threshold threshold)
+  {
+    return {threshold};
+  }
+
+  // Bounds are scalars or ranges of per-sample bounds; ranges are viewed,
+  // not copied, and must outlive the expression
+  template <typename MinBound, typename MaxBound>
+  WithinPredicate<MinBound, MaxBound> within(const MinBound &min_bound, const MaxBound &max_bound)
+  {
+    return {{min_bound}, {max_bound}};
+  }
+
+  template <typename Function>
+  constexpr WherePredicate<Function> where(Function function)
+  {
+    return {function};
+  }
+
+  // Quantifiers. Each holds the state of one evaluation: push() takes the
+  // next sample, isDecided() tells whether further samples can still change
+  // verdict().
+
+  template <typename Predicate>
+  struct AllQuantifier
+  {
+    static constexpr bool kIsQuantifier = true;
+    Predicate predicate;
+    bool holds = true;
+
+    template <typename T>
+    void push(T value, size_t index) { holds &= predicate(value, index); }
+    bool isDecided() const { return !holds; }
+    bool verdict() const { return holds; }
+    bool matchesSize(size_t size) const { return predicate.matchesSize(size); }
+  };
+
+  template <typename Predicate>
+  struct AnyQuantifier
+  {
+    static constexpr bool kIsQuantifier = true;
+    Predicate predicate;
+    bool found = false;
+
+    template <typename T>
+    void push(T value, size_t index) { found |= predicate(value, index); }
+    bool isDecided() const { return found; }
+    bool verdict() const { return found; }
+    bool matchesSize(size_t size) const { return predicate.matchesSize(size); }
+  };
+
+  template <typename Predicate>
+  struct CountAtLeastQuantifier
+  {
+    static constexpr bool kIsQuantifier = true;
+    size_t min_samples;
+    Predicate predicate;
+    size_t count = 0;
+
+    template <typename T>
+    void push(T value, size_t index) { count += predicate(value, index) ? 1 : 0; }
+    bool isDecided() const { return count >= min_samples; }
+    bool verdict() const { return count >= min_samples; }
+    bool matchesSize(size_t size) const { return predicate.matchesSize(size); }
+  };
+
+  template <typename Predicate>
+  struct RunAtLeastQuantifier
+  {
+    static constexpr bool kIsQuantifier = true;
+    size_t min_consecutive;
+    Predicate predicate;
+    size_t run = 0;
+    size_t longest_run = 0;
+
+    template <typename T>
+    void push(T value, size_t index)
+    {
+      run = predicate(value, index) ? run + 1 : 0;
+      longest_run = std::max(longest_run, run);
+    }
+
+    bool isDecided() const { return longest_run >= min_consecutive; }
+    bool verdict() const { return longest_run >= min_consecutive; }
+    bool matchesSize(size_t size) const { return predicate.matchesSize(size); }
+  };
+
+  template <typename Left, typename Right>
+  struct AndQuantifier
+  {
+    static constexpr bool kIsQuantifier = true;
+    Left left;
+    Right right;
+
+    template <typename T>
+    void push(T value, size_t index)
+    {
+      left.push(value, index);
+      right.push(value, index);
+    }
+
+    bool isDecided() const
+    {
+      return (left.isDecided() && !left.verdict()) || (right.isDecided() && !right.verdict()) ||
+             (left.isDecided() && right.isDecided());
+    }
+
+    bool verdict() const { return left.verdict() && right.verdict(); }
+    bool matchesSize(size_t size) const { return left.matchesSize(size) && right.matchesSize(size); }
+  };
+
+  template <typename Left, typename Right>
+  struct OrQuantifier
+  {
+    static constexpr bool kIsQuantifier = true;
+    Left left;
+    Right right;
+
+    template <typename T>
+    void push(T value, size_t index)
+    {
+      left.push(value, index);
+      right.push(value, index);
+    }
+
+    bool isDecided() const
+    {
+      return (left.isDecided() && left.verdict()) || (right.isDecided() && right.verdict()) ||
+             (left.isDecided() && right.isDecided());
+    }
+
+    bool verdict() const { return left.verdict() || right.verdict(); }
+    bool matchesSize(size_t size) const { return left.matchesSize(size) && right.matchesSize(size); }
+  };
+
+  template <typename Inner>
+  struct NotQuantifier
+  {
+    static constexpr bool kIsQuantifier = true;
+    Inner inner;
+
+    template <typename T>
+    void push(T value, size_t index) { inner.push(value, index); }
+    bool isDecided() const { return inner.isDecided(); }
+    bool verdict() const { return !inner.verdict(); }
+    bool matchesSize(size_t size) const { return inner.matchesSize(size); }
+  };
+
+  template <typename Predicate, typename = std::enable_if_t<detail::IsPredicateNode<Predicate>::value>>
+  constexpr AllQuantifier<Predicate> all(Predicate predicate)
+  {
+    return {predicate};
+  }
+
+  template <typename Predicate, typename = std::enable_if_t<detail::IsPredicateNode<Predicate>::value>>
+  constexpr AnyQuantifier<Predicate> any(Predicate predicate)
+  {
+    return {predicate};
+  }
+
+  // At least min_samples samples, not necessarily consecutive
+  template <typename Predicate, typename = std::enable_if_t<detail::IsPredicateNode<Predicate>::value>>
+  constexpr CountAtLeastQuantifier<Predicate> countAtLeast(size_t min_samples, Predicate predicate)
+  {
+    return {min_samples, predicate};
+  }
+
+  // At least min_consecutive consecutive samples
+  template <typename Predicate, typename = std::enable_if_t<detail::IsPredicateNode<Predicate>::value>>
+  constexpr RunAtLeastQuantifier<Predicate> runAtLeast(size_t min_consecutive, Predicate predicate)
+  {
+    return {min_consecutive, predicate};
+  }
+
+  template <typename Left, typename Right,
+            typename = std::enable_if_t<detail::IsPredicateNode<Left>::value && detail::IsPredicateNode<Right>::value>>
+  constexpr AndPredicate<Left, Right> operator&&(Left left, Right right)
+  {
+    return {left, right};
+  }
+
+  template <typename Left, typename Right,
+            typename = std::enable_if_t<detail::IsPredicateNode<Left>::value && detail::IsPredicateNode<Right>::value>>
+  constexpr OrPredicate<Left, Right> operator||(Left left, Right right)
+  {
+    return {left, right};
+  }
+
+  template <typename Inner, typename = std::enable_if_t<detail::IsPredicateNode<Inner>::value>>
+  constexpr NotPredicate<Inner> operator!(Inner inner)
+  {
+    return {inner};
+  }
+
+  template <typename Left, typename Right, typename = void,
+            typename = std::enable_if_t<detail::IsQuantifierNode<Left>::value && detail::IsQuantifierNode<Right>::value>>
+  constexpr AndQuantifier<Left, Right> operator&&(Left left, Right right)
+  {
+    return {left, right};
+  }
+
+  template <typename Left, typename Right, typename = void,
+            typename = std::enable_if_t<detail::IsQuantifierNode<Left>::value && detail::IsQuantifierNode<Right>::value>>
+  constexpr OrQuantifier<Left, Right> operator||(Left left, Right right)
+  {
+    return {left, right};
+  }
+
+  template <typename Inner, typename = void, typename = std::enable_if_t<detail::IsQuantifierNode<Inner>::value>>
+  constexpr NotQuantifier<Inner> operator!(Inner inner)
+  {
+    return {inner};
+  }
+
+  // Samples pushed between two isDecided() checks. Keeps the inner loop free
+  // of the exit test so the compiler can unroll or vectorise it.
+  constexpr size_t kExpressionBlockSize = 256;
+
+  // Evaluates a quantifier expression over test_vector in a single pass.
+  // Returns false if a per-sample bound range has a different size.
+  template <typename Range, typename Expression>
+  bool isSatisfied(const Range &test_vector, Expression expression)
+  {
+    using T = RangeValueType<Range>;
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                  "isSatisfied only supports float and double types");
+    static_assert(detail::IsQuantifierNode<Expression>::value,
+                  "isSatisfied requires a quantifier such as all(), any() or runAtLeast()");
+
+    const size_t n = test_vector.size();
+    if (!expression.matchesSize(n))
+    {
+      return false;
+    }
+
+    for (size_t start = 0; start < n && !expression.isDecided(); start += kExpressionBlockSize)
+    {
+      const size_t end = std::min(n, start + kExpressionBlockSize);
+      if constexpr (IsContiguousRange<Range>::value)
+      {
+        const T *data = test_vector.data();
+        for (size_t i = start; i < end; ++i)
+        {
+          expression.push(data[i], i);
+        }
+      }
+      else
+      {
+        for (size_t i = start; i < end; ++i)
+        {
+          expression.push(test_vector[i], i);
+        }
+      }
+    }
+
+    return expression.verdict();
+  }
+
+}
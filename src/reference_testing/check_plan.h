@@ -0,0 +1,513 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <type_traits>
+#include <stdexcept>
+#include <limits>
+#include <initializer_list>
+#include <cstddef>
+
+#include <nlohmann/json.hpp>
+
+#include "reference_testing/ranges.h"
+#include "reference_testing/bounds_checker.h"
+#include "reference_testing/online_checkers.h"
+#include "reference_testing/duration_checkers.h"
+#include "reference_testing/check_set.h"
+#include "reference_testing/time_window.h"
+#include "reference_testing/signal_set.h"
+
+namespace lumos
+{
+
+  // Check suites defined in JSON, so test engineers can change checks and
+  // thresholds without recompiling:
+  //
+  //   {
+  //     "checks": [
+  //       {"name": "x bounds", "type": "within_bounds", "channel": "x", "min": "x_min", "max": "x_max"},
+  //       {"name": "x variance", "type": "variance_within_threshold", "channel": "x",
+  //        "reference": "x_ref", "threshold": 0.01},
+  //       {"name": "x settles", "type": "below_threshold_for_duration", "channel": "x",
+  //        "threshold": 0.1, "min_duration": 2.0, "window": {"start": 5.0, "stop": 10.0}}
+  //     ]
+  //   }
+  //
+  // The JSON is parsed once into a CheckPlan. bind() resolves every channel
+  // name and time window against the loaded signals and yields a
+  // BoundCheckPlan holding only spans and typed parameters, so evaluation
+  // does no JSON access or string lookups. Each step runs on the same
+  // kernels as the corresponding free checker, so verdicts and values match
+  // a direct call bit for bit:
+  //
+  //   const CheckPlan plan = CheckPlan::load("checks.json");
+  //   const BoundCheckPlan<double> bound = plan.bind(test_signals, reference_signals);
+  //   std::vector<CheckResult<double>> results = bound.evaluate();
+  //
+  // Check types and their parameters:
+  //   within_bounds                         min, max (reference channels), time_based (default false)
+  //   variance_within_threshold             reference, threshold
+  //   mean_difference_within_threshold      reference, threshold
+  //   samples_above_threshold               threshold, min_samples
+  //   samples_below_threshold               threshold, min_samples
+  //   consecutive_samples_above_threshold   threshold, min_samples
+  //   consecutive_samples_below_threshold   threshold, min_samples
+  //   above_threshold_for_duration          threshold, min_duration
+  //   below_threshold_for_duration          threshold, min_duration
+  // Every check takes a name, a test channel and an optional window on the
+  // test timebase; any other key is rejected. Index-aligned reference channels are cut to the same
+  // window; time_based bounds are looked up on the reference timebase.
+  //
+  // This is the only header that depends on nlohmann/json, so it is not part
+  // of reference_testing.h; include it directly where plans are used.
+
+  enum class PlanCheckKind
+  {
+    WithinBounds,
+    VarianceWithinThreshold,
+    MeanDifferenceWithinThreshold,
+    SamplesAboveThreshold,
+    SamplesBelowThreshold,
+    ConsecutiveSamplesAboveThreshold,
+    ConsecutiveSamplesBelowThreshold,
+    AboveThresholdForDuration,
+    BelowThresholdForDuration
+  };
+
+  // One check as declared in the plan, before channels are resolved
+  struct PlanCheck
+  {
+    std::string name;
+    PlanCheckKind kind;
+    std::string channel;
+    std::string reference;
+    std::string min_bounds;
+    std::string max_bounds;
+    bool time_based;
+    double threshold;
+    size_t min_samples;
+    double min_duration;
+    bool has_window;
+    double window_start;
+    double window_stop;
+  };
+
+  template <typename T>
+  class BoundCheckPlan
+  {
+  public:
+    size_t size() const { return steps_.size(); }
+
+    std::vector<CheckResult<T>> evaluate() const
+    {
+      std::vector<CheckResult<T>> results;
+      evaluate(results);
+      return results;
+    }
+
+    // Writes into an existing vector, reusing the capacity of its names
+    void evaluate(std::vector<CheckResult<T>> &results) const
+    {
+      results.resize(steps_.size());
+      for (size_t s = 0; s < steps_.size(); ++s)
+      {
+        const Step &step = steps_[s];
+        CheckResult<T> &result = results[s];
+        result.name = step.name;
+        result.passed = false;
+        result.value = T(0);
+        result.samples_evaluated = 0;
+
+        switch (step.kind)
+        {
+        case PlanCheckKind::WithinBounds:
+          if (step.time_based)
+          {
+            result.passed = isWithinBounds(step.test_time, step.test, step.reference_time, step.min_bounds,
+                                           step.reference_time, step.max_bounds);
+            result.samples_evaluated = step.test.size();
+          }
+          else if (step.min_bounds.size() == step.test.size() && step.max_bounds.size() == step.test.size())
+          {
+            const size_t n = step.test.size();
+            const size_t first = findFirstOutsideBounds(step.test.data(), step.min_bounds.data(),
+                                                        step.max_bounds.data(), n);
+            result.passed = first == n;
+            result.samples_evaluated = result.passed ? n : first + 1;
+          }
+          break;
+        case PlanCheckKind::VarianceWithinThreshold:
+          if (step.reference.size() == step.test.size())
+          {
+            result.value = step.test.empty() ? T(0) : detail::differenceVariance(step.test, step.reference);
+            result.passed = step.test.empty() || result.value <= step.threshold;
+            result.samples_evaluated = step.test.size();
+          }
+          break;
+        case PlanCheckKind::MeanDifferenceWithinThreshold:
+          if (step.reference.size() == step.test.size())
+          {
+            result.value = step.test.empty() ? T(0) : detail::meanDifference(step.test, step.reference);
+            result.passed = step.test.empty() || result.value <= step.threshold;
+            result.samples_evaluated = step.test.size();
+          }
+          break;
+        case PlanCheckKind::SamplesAboveThreshold:
+          runCount<true>(step, result);
+          break;
+        case PlanCheckKind::SamplesBelowThreshold:
+          runCount<false>(step, result);
+          break;
+        case PlanCheckKind::ConsecutiveSamplesAboveThreshold:
+          runRun(OnlineConsecutiveSamplesAboveThreshold<T>(step.threshold, step.min_samples, step.test.size()),
+                 step, result);
+          break;
+        case PlanCheckKind::ConsecutiveSamplesBelowThreshold:
+          runRun(OnlineConsecutiveSamplesBelowThreshold<T>(step.threshold, step.min_samples, step.test.size()),
+                 step, result);
+          break;
+        case PlanCheckKind::AboveThresholdForDuration:
+          runDuration(OnlineDurationAboveThreshold<T>(step.threshold, step.min_duration, endTime(step)), step,
+                      result);
+          break;
+        case PlanCheckKind::BelowThresholdForDuration:
+          runDuration(OnlineDurationBelowThreshold<T>(step.threshold, step.min_duration, endTime(step)), step,
+                      result);
+          break;
+        }
+      }
+    }
+
+  private:
+    friend class CheckPlan;
+
+    // A check with its channels resolved and any window already applied
+    struct Step
+    {
+      PlanCheckKind kind;
+      std::string name;
+      bool time_based;
+      T threshold;
+      size_t min_samples;
+      T min_duration;
+      Span<const T> test_time;
+      Span<const T> test;
+      Span<const T> reference_time;
+      Span<const T> reference;
+      Span<const T> min_bounds;
+      Span<const T> max_bounds;
+    };
+
+    BoundCheckPlan()
+    {
+      static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                    "BoundCheckPlan only supports float and double types");
+    }
+
+    template <typename E>
+    static void store(const E &evaluator, T value, CheckResult<T> &result)
+    {
+      result.passed = evaluator.verdict();
+      result.value = value;
+      result.samples_evaluated = evaluator.samplesSeen();
+    }
+
+    template <bool Above>
+    static void runCount(const Step &step, CheckResult<T> &result)
+    {
+      const size_t count = detail::countPastThreshold<Above>(step.test, step.threshold, step.min_samples,
+                                                             result.samples_evaluated);
+      result.passed = count >= step.min_samples;
+      result.value = static_cast<T>(count);
+    }
+
+    template <typename E>
+    static void runRun(E evaluator, const Step &step, CheckResult<T> &result)
+    {
+      evaluator.push(step.test);
+      store(evaluator, static_cast<T>(evaluator.longestRun()), result);
+    }
+
+    template <typename E>
+    static void runDuration(E evaluator, const Step &step, CheckResult<T> &result)
+    {
+      evaluator.push(step.test_time, step.test);
+      store(evaluator, evaluator.longestRun().duration(), result);
+    }
+
+    // Lets duration checks fail early once the window cannot fit a run
+    static T endTime(const Step &step)
+    {
+      return step.test_time.empty() ? std::numeric_limits<T>::infinity() : step.test_time[step.test_time.size() - 1];
+    }
+
+    std::vector<Step> steps_;
+  };
+
+  class CheckPlan
+  {
+  public:
+    static CheckPlan fromJson(const nlohmann::json &document)
+    {
+      if (!document.is_object() || !document.contains("checks") || !document["checks"].is_array())
+      {
+        throw std::runtime_error("Check plan must be an object with a \"checks\" array");
+      }
+
+      CheckPlan plan;
+      for (const nlohmann::json &entry : document["checks"])
+      {
+        plan.checks_.push_back(parseCheck(entry, plan.checks_.size()));
+      }
+      return plan;
+    }
+
+    static CheckPlan fromString(const std::string &text)
+    {
+      nlohmann::json document = nlohmann::json::parse(text, nullptr, false);
+      if (document.is_discarded())
+      {
+        throw std::runtime_error("Check plan is not valid JSON");
+      }
+      return fromJson(document);
+    }
+
+    static CheckPlan load(const std::string &filename)
+    {
+      std::ifstream file(filename);
+      if (!file)
+      {
+        throw std::runtime_error("Could not open check plan: " + filename);
+      }
+
+      std::stringstream buffer;
+      buffer << file.rdbuf();
+      try
+      {
+        return fromString(buffer.str());
+      }
+      catch (const std::runtime_error &error)
+      {
+        throw std::runtime_error(filename + ": " + error.what());
+      }
+    }
+
+    const std::vector<PlanCheck> &checks() const { return checks_; }
+    size_t size() const { return checks_.size(); }
+
+    // Resolves channel names and windows once. The signal sets must outlive
+    // the bound plan; unknown channels throw std::runtime_error.
+    template <typename T>
+    BoundCheckPlan<T> bind(const SignalSet<T> &test_signals, const SignalSet<T> &reference_signals) const
+    {
+      BoundCheckPlan<T> bound;
+      bound.steps_.reserve(checks_.size());
+      for (const PlanCheck &check : checks_)
+      {
+        typename BoundCheckPlan<T>::Step step{};
+        step.kind = check.kind;
+        step.name = check.name;
+        step.time_based = check.time_based;
+        step.threshold = static_cast<T>(check.threshold);
+        step.min_samples = check.min_samples;
+        step.min_duration = static_cast<T>(check.min_duration);
+        step.test_time = test_signals.time();
+        step.test = resolve(test_signals, check.channel, check);
+        step.reference_time = reference_signals.time();
+        if (!check.reference.empty())
+        {
+          step.reference = resolve(reference_signals, check.reference, check);
+        }
+        if (!check.min_bounds.empty())
+        {
+          step.min_bounds = resolve(reference_signals, check.min_bounds, check);
+          step.max_bounds = resolve(reference_signals, check.max_bounds, check);
+        }
+
+        if (check.has_window)
+        {
+          const IndexRange window = findTimeWindow(step.test_time, static_cast<T>(check.window_start),
+                                                   static_cast<T>(check.window_stop));
+          // Index-aligned references follow the test window; references of
+          // another size are left whole and fail the size check
+          const bool aligned = reference_signals.size() == test_signals.size() && !check.time_based;
+          step.test_time = windowOf(step.test_time, window);
+          step.test = windowOf(step.test, window);
+          if (aligned)
+          {
+            step.reference = step.reference.empty() ? step.reference : windowOf(step.reference, window);
+            step.min_bounds = step.min_bounds.empty() ? step.min_bounds : windowOf(step.min_bounds, window);
+            step.max_bounds = step.max_bounds.empty() ? step.max_bounds : windowOf(step.max_bounds, window);
+          }
+        }
+
+        bound.steps_.push_back(step);
+      }
+      return bound;
+    }
+
+    // The bound plan keeps spans into the signal sets, so temporaries would
+    // leave them dangling
+    template <typename T>
+    BoundCheckPlan<T> bind(const SignalSet<T> &&test_signals, const SignalSet<T> &reference_signals) const = delete;
+    template <typename T>
+    BoundCheckPlan<T> bind(const SignalSet<T> &test_signals, const SignalSet<T> &&reference_signals) const = delete;
+    template <typename T>
+    BoundCheckPlan<T> bind(const SignalSet<T> &&test_signals, const SignalSet<T> &&reference_signals) const = delete;
+
+  private:
+    static PlanCheckKind parseKind(const std::string &type, const std::string &context)
+    {
+      static const std::pair<const char *, PlanCheckKind> kinds[] = {
+          {"within_bounds", PlanCheckKind::WithinBounds},
+          {"variance_within_threshold", PlanCheckKind::VarianceWithinThreshold},
+          {"mean_difference_within_threshold", PlanCheckKind::MeanDifferenceWithinThreshold},
+          {"samples_above_threshold", PlanCheckKind::SamplesAboveThreshold},
+          {"samples_below_threshold", PlanCheckKind::SamplesBelowThreshold},
+          {"consecutive_samples_above_threshold", PlanCheckKind::ConsecutiveSamplesAboveThreshold},
+          {"consecutive_samples_below_threshold", PlanCheckKind::ConsecutiveSamplesBelowThreshold},
+          {"above_threshold_for_duration", PlanCheckKind::AboveThresholdForDuration},
+          {"below_threshold_for_duration", PlanCheckKind::BelowThresholdForDuration}};
+
+      for (const auto &[name, kind] : kinds)
+      {
+        if (type == name)
+        {
+          return kind;
+        }
+      }
+      throw std::runtime_error(context + ": unknown check type " + type);
+    }
+
+    static std::string requireString(const nlohmann::json &entry, const char *key, const std::string &context)
+    {
+      if (!entry.contains(key) || !entry[key].is_string())
+      {
+        throw std::runtime_error(context + ": \"" + key + "\" must be a string");
+      }
+      return entry[key].get<std::string>();
+    }
+
+    static double requireNumber(const nlohmann::json &entry, const char *key, const std::string &context)
+    {
+      if (!entry.contains(key) || !entry[key].is_number())
+      {
+        throw std::runtime_error(context + ": \"" + key + "\" must be a number");
+      }
+      return entry[key].get<double>();
+    }
+
+    static size_t requireCount(const nlohmann::json &entry, const char *key, const std::string &context)
+    {
+      if (!entry.contains(key) || !entry[key].is_number_unsigned())
+      {
+        throw std::runtime_error(context + ": \"" + key + "\" must be a non-negative integer");
+      }
+      return entry[key].get<size_t>();
+    }
+
+    // Misspelled optional keys would silently change what a check does
+    static void rejectUnknownKeys(const nlohmann::json &entry, std::initializer_list<const char *> allowed,
+                                  const std::string &context)
+    {
+      for (auto it = entry.begin(); it != entry.end(); ++it)
+      {
+        bool known = false;
+        for (const char *key : allowed)
+        {
+          known = known || it.key() == key;
+        }
+        if (!known)
+        {
+          throw std::runtime_error(context + ": unknown key \"" + it.key() + "\"");
+        }
+      }
+    }
+
+    static PlanCheck parseCheck(const nlohmann::json &entry, size_t index)
+    {
+      std::string context = "Check " + std::to_string(index);
+      if (!entry.is_object())
+      {
+        throw std::runtime_error(context + " must be an object");
+      }
+
+      PlanCheck check{};
+      check.name = requireString(entry, "name", context);
+      context += " (" + check.name + ")";
+      check.kind = parseKind(requireString(entry, "type", context), context);
+      check.channel = requireString(entry, "channel", context);
+
+      switch (check.kind)
+      {
+      case PlanCheckKind::WithinBounds:
+        rejectUnknownKeys(entry, {"name", "type", "channel", "window", "min", "max", "time_based"}, context);
+        check.min_bounds = requireString(entry, "min", context);
+        check.max_bounds = requireString(entry, "max", context);
+        if (entry.contains("time_based"))
+        {
+          if (!entry["time_based"].is_boolean())
+          {
+            throw std::runtime_error(context + ": \"time_based\" must be a boolean");
+          }
+          check.time_based = entry["time_based"].get<bool>();
+        }
+        break;
+      case PlanCheckKind::VarianceWithinThreshold:
+      case PlanCheckKind::MeanDifferenceWithinThreshold:
+        rejectUnknownKeys(entry, {"name", "type", "channel", "window", "reference", "threshold"}, context);
+        check.reference = requireString(entry, "reference", context);
+        check.threshold = requireNumber(entry, "threshold", context);
+        break;
+      case PlanCheckKind::SamplesAboveThreshold:
+      case PlanCheckKind::SamplesBelowThreshold:
+      case PlanCheckKind::ConsecutiveSamplesAboveThreshold:
+      case PlanCheckKind::ConsecutiveSamplesBelowThreshold:
+        rejectUnknownKeys(entry, {"name", "type", "channel", "window", "threshold", "min_samples"}, context);
+        check.threshold = requireNumber(entry, "threshold", context);
+        check.min_samples = requireCount(entry, "min_samples", context);
+        break;
+      case PlanCheckKind::AboveThresholdForDuration:
+      case PlanCheckKind::BelowThresholdForDuration:
+        rejectUnknownKeys(entry, {"name", "type", "channel", "window", "threshold", "min_duration"}, context);
+        check.threshold = requireNumber(entry, "threshold", context);
+        check.min_duration = requireNumber(entry, "min_duration", context);
+        break;
+      }
+
+      if (entry.contains("window"))
+      {
+        const nlohmann::json &window = entry["window"];
+        if (!window.is_object())
+        {
+          throw std::runtime_error(context + ": \"window\" must be an object with start and stop");
+        }
+        rejectUnknownKeys(window, {"start", "stop"}, context + " window");
+        check.has_window = true;
+        check.window_start = requireNumber(window, "start", context + " window");
+        check.window_stop = requireNumber(window, "stop", context + " window");
+        if (check.window_stop < check.window_start)
+        {
+          throw std::runtime_error(context + ": window must not end before it starts");
+        }
+      }
+      return check;
+    }
+
+    template <typename T>
+    static Span<const T> resolve(const SignalSet<T> &signals, const std::string &channel, const PlanCheck &check)
+    {
+      if (!signals.hasChannel(channel))
+      {
+        throw std::runtime_error("Check " + check.name + " refers to unknown channel " + channel);
+      }
+      return signals.channel(channel);
+    }
+
+    std::vector<PlanCheck> checks_;
+  };
+
+}
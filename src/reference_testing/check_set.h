@@ -0,0 +1,298 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <variant>
+#include <memory_resource>
+#include <type_traits>
+#include <stdexcept>
+#include <algorithm>
+
+#include "reference_testing/ranges.h"
+#include "reference_testing/online_checkers.h"
+
+namespace lumos
+{
+
+  template <typename T>
+  struct CheckResult
+  {
+    std::string name;
+    bool passed;
+    // Variance, mean difference, sample count or longest run depending on
+    // the check, zero for bounds checks. Taken when the check was decided,
+    // which may be before all samples were evaluated.
+    T value;
+    size_t samples_evaluated;
+  };
+
+  // A set of checks against one test/reference pair that is evaluated in a
+  // single fused pass. The data is walked in cache-sized blocks and every
+  // check consumes a block before the next one is loaded, so each sample is
+  // streamed from memory once no matter how many checks are declared.
+  //
+  //   CheckSet<double> checks;
+  //   checks.addWithinBounds("x bounds", x_min, x_max)
+  //       .addVarianceWithinThreshold("x variance", 0.1)
+  //       .addMeanDifferenceWithinThreshold("x mean", 0.05);
+  //   std::vector<CheckResult<double>> results = checks.evaluate(sensor_x, ref_x);
+  //
+  // Bound ranges are referenced, not copied, and must outlive the set.
+  template <typename T>
+  class CheckSet
+  {
+  public:
+    static constexpr size_t kBlockSize = 4096;
+
+    CheckSet()
+    {
+      static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                    "CheckSet only supports float and double types");
+    }
+
+    template <typename BoundRange>
+    CheckSet &addWithinBounds(const std::string &name, const BoundRange &min_bounds, const BoundRange &max_bounds)
+    {
+      Check check{CheckKind::WithinBounds, name, T(0), 0, Span<const T>(min_bounds), Span<const T>(max_bounds)};
+      checks_.push_back(check);
+      return *this;
+    }
+
+    CheckSet &addVarianceWithinThreshold(const std::string &name, T threshold)
+    {
+      checks_.push_back(Check{CheckKind::VarianceWithinThreshold, name, threshold, 0, {}, {}});
+      return *this;
+    }
+
+    CheckSet &addMeanDifferenceWithinThreshold(const std::string &name, T threshold)
+    {
+      checks_.push_back(Check{CheckKind::MeanDifferenceWithinThreshold, name, threshold, 0, {}, {}});
+      return *this;
+    }
+
+    CheckSet &addSamplesAboveThreshold(const std::string &name, T threshold, size_t min_samples)
+    {
+      checks_.push_back(Check{CheckKind::SamplesAboveThreshold, name, threshold, min_samples, {}, {}});
+      return *this;
+    }
+
+    CheckSet &addSamplesBelowThreshold(const std::string &name, T threshold, size_t min_samples)
+    {
+      checks_.push_back(Check{CheckKind::SamplesBelowThreshold, name, threshold, min_samples, {}, {}});
+      return *this;
+    }
+
+    CheckSet &addConsecutiveSamplesAboveThreshold(const std::string &name, T threshold, size_t min_consecutive)
+    {
+      checks_.push_back(Check{CheckKind::ConsecutiveSamplesAboveThreshold, name, threshold, min_consecutive, {}, {}});
+      return *this;
+    }
+
+    CheckSet &addConsecutiveSamplesBelowThreshold(const std::string &name, T threshold, size_t min_consecutive)
+    {
+      checks_.push_back(Check{CheckKind::ConsecutiveSamplesBelowThreshold, name, threshold, min_consecutive, {}, {}});
+      return *this;
+    }
+
+    size_t size() const
+    {
+      return checks_.size();
+    }
+
+    template <typename TestRange, typename ReferenceRange>
+    std::vector<CheckResult<T>> evaluate(const TestRange &test_vector, const ReferenceRange &reference_vector) const
+    {
+      std::vector<CheckResult<T>> results;
+      evaluate(test_vector, reference_vector, results);
+      return results;
+    }
+
+    // Writes the results into an existing vector and takes the per-call
+    // state from scratch, e.g. a MonotonicArena. Reusing both across runs
+    // avoids heap allocations once the result names fit their storage.
+    template <typename TestRange, typename ReferenceRange>
+    void evaluate(const TestRange &test_vector, const ReferenceRange &reference_vector,
+                  std::vector<CheckResult<T>> &results,
+                  std::pmr::memory_resource *scratch = std::pmr::get_default_resource()) const
+    {
+      static_assert(std::is_same_v<T, RangeValueType<TestRange>> &&
+                        std::is_same_v<T, RangeValueType<ReferenceRange>>,
+                    "CheckSet::evaluate requires test and reference ranges of the set's value type");
+
+      const Span<const T> test(test_vector);
+      const Span<const T> reference(reference_vector);
+      const size_t n = test.size();
+
+      std::pmr::vector<Evaluator> evaluators(scratch);
+      std::pmr::vector<unsigned char> active(checks_.size(), 1, scratch);
+      evaluators.reserve(checks_.size());
+      for (size_t c = 0; c < checks_.size(); ++c)
+      {
+        evaluators.push_back(makeEvaluator(checks_[c], n));
+        if (!sizesMatch(checks_[c], n, reference.size()))
+        {
+          active[c] = 0;
+        }
+      }
+
+      for (size_t start = 0; start < n; start += kBlockSize)
+      {
+        const size_t count = std::min(kBlockSize, n - start);
+        bool any_pending = false;
+
+        for (size_t c = 0; c < checks_.size(); ++c)
+        {
+          if (!active[c])
+          {
+            continue;
+          }
+
+          const Check &check = checks_[c];
+          const Span<const T> test_block = test.subspan(start, count);
+          std::visit(
+              [&](auto &evaluator)
+              {
+                using E = std::decay_t<decltype(evaluator)>;
+                if constexpr (std::is_same_v<E, OnlineWithinBounds<T>>)
+                {
+                  evaluator.push(test_block, check.min_bounds.subspan(start, count),
+                                 check.max_bounds.subspan(start, count));
+                }
+                else if constexpr (std::is_same_v<E, OnlineVarianceWithinThreshold<T>> ||
+                                   std::is_same_v<E, OnlineMeanDifferenceWithinThreshold<T>>)
+                {
+                  evaluator.push(test_block, reference.subspan(start, count));
+                }
+                else
+                {
+                  evaluator.push(test_block);
+                }
+
+                if (evaluator.isDecided())
+                {
+                  active[c] = 0;
+                }
+              },
+              evaluators[c]);
+
+          any_pending = any_pending || active[c] != 0;
+        }
+
+        if (!any_pending)
+        {
+          break;
+        }
+      }
+
+      // Assigning into existing results reuses the capacity of their names
+      results.resize(checks_.size());
+      for (size_t c = 0; c < checks_.size(); ++c)
+      {
+        CheckResult<T> &result = results[c];
+        result.name = checks_[c].name;
+        if (!sizesMatch(checks_[c], n, reference.size()))
+        {
+          result.passed = false;
+          result.value = T(0);
+          result.samples_evaluated = 0;
+          continue;
+        }
+
+        std::visit(
+            [&](const auto &evaluator)
+            {
+              result.passed = evaluator.verdict();
+              result.value = resultValue(evaluator);
+              result.samples_evaluated = evaluator.samplesSeen();
+            },
+            evaluators[c]);
+      }
+    }
+
+  private:
+    enum class CheckKind
+    {
+      WithinBounds,
+      VarianceWithinThreshold,
+      MeanDifferenceWithinThreshold,
+      SamplesAboveThreshold,
+      SamplesBelowThreshold,
+      ConsecutiveSamplesAboveThreshold,
+      ConsecutiveSamplesBelowThreshold
+    };
+
+    struct Check
+    {
+      CheckKind kind;
+      std::string name;
+      T threshold;
+      size_t min_samples;
+      Span<const T> min_bounds;
+      Span<const T> max_bounds;
+    };
+
+    using Evaluator = std::variant<OnlineWithinBounds<T>,
+                                   OnlineVarianceWithinThreshold<T>,
+                                   OnlineMeanDifferenceWithinThreshold<T>,
+                                   OnlineSamplesAboveThreshold<T>,
+                                   OnlineSamplesBelowThreshold<T>,
+                                   OnlineConsecutiveSamplesAboveThreshold<T>,
+                                   OnlineConsecutiveSamplesBelowThreshold<T>>;
+
+    static bool sizesMatch(const Check &check, size_t test_size, size_t reference_size)
+    {
+      switch (check.kind)
+      {
+      case CheckKind::WithinBounds:
+        return check.min_bounds.size() == test_size && check.max_bounds.size() == test_size;
+      case CheckKind::VarianceWithinThreshold:
+      case CheckKind::MeanDifferenceWithinThreshold:
+        return reference_size == test_size;
+      default:
+        return true;
+      }
+    }
+
+    static Evaluator makeEvaluator(const Check &check, size_t expected_samples)
+    {
+      switch (check.kind)
+      {
+      case CheckKind::WithinBounds:
+        return OnlineWithinBounds<T>();
+      case CheckKind::VarianceWithinThreshold:
+        return OnlineVarianceWithinThreshold<T>(check.threshold, expected_samples);
+      case CheckKind::MeanDifferenceWithinThreshold:
+        return OnlineMeanDifferenceWithinThreshold<T>(check.threshold);
+      case CheckKind::SamplesAboveThreshold:
+        return OnlineSamplesAboveThreshold<T>(check.threshold, check.min_samples, expected_samples);
+      case CheckKind::SamplesBelowThreshold:
+        return OnlineSamplesBelowThreshold<T>(check.threshold, check.min_samples, expected_samples);
+      case CheckKind::ConsecutiveSamplesAboveThreshold:
+        return OnlineConsecutiveSamplesAboveThreshold<T>(check.threshold, check.min_samples, expected_samples);
+      case CheckKind::ConsecutiveSamplesBelowThreshold:
+        return OnlineConsecutiveSamplesBelowThreshold<T>(check.threshold, check.min_samples, expected_samples);
+      }
+      throw std::logic_error("Unknown check kind");
+    }
+
+    template <typename E>
+    static T resultValue(const E &evaluator)
+    {
+      if constexpr (std::is_same_v<E, OnlineVarianceWithinThreshold<T>>)
+        return evaluator.variance();
+      else if constexpr (std::is_same_v<E, OnlineMeanDifferenceWithinThreshold<T>>)
+        return evaluator.meanDifference();
+      else if constexpr (std::is_same_v<E, OnlineSamplesAboveThreshold<T>> ||
+                         std::is_same_v<E, OnlineSamplesBelowThreshold<T>>)
+        return static_cast<T>(evaluator.count());
+      else if constexpr (std::is_same_v<E, OnlineConsecutiveSamplesAboveThreshold<T>> ||
+                         std::is_same_v<E, OnlineConsecutiveSamplesBelowThreshold<T>>)
+        return static_cast<T>(evaluator.longestRun());
+      else
+        return T(0);
+    }
+
+    std::vector<Check> checks_;
+  };
+
+}
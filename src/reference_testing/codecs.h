@@ -0,0 +1,499 @@
+#pragma once
+
+#include <vector>
+#include <type_traits>
+#include <stdexcept>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+
+namespace lumos
+{
+
+    // How a channel payload is stored. Raw is element_count * sizeof(T)
+    // bytes in native byte order; the other encodings are block streams
+    // written by encodeBlocks() in a host-independent byte order.
+    //
+    // DeltaOfDelta stores the second difference of the element bit patterns,
+    // bitpacked at the smallest width per block. Monotonic timestamps and
+    // counters compress to a few bits per sample. XorFloat is the Gorilla
+    // scheme: each value is XORed with its predecessor and only the
+    // meaningful bits of the result are kept, which suits smooth signals.
+    enum class ContainerEncoding : uint8_t
+    {
+        Raw = 0,
+        DeltaOfDelta = 1,
+        XorFloat = 2
+    };
+
+    // Elements per independently decodable block
+    constexpr size_t kCodecBlockSize = 4096;
+
+    namespace detail
+    {
+        template <size_t Size>
+        struct UnsignedOfSize;
+
+        template <> struct UnsignedOfSize<1> { using type = uint8_t; };
+        template <> struct UnsignedOfSize<2> { using type = uint16_t; };
+        template <> struct UnsignedOfSize<4> { using type = uint32_t; };
+        template <> struct UnsignedOfSize<8> { using type = uint64_t; };
+
+        template <typename T>
+        using BitsOf = typename UnsignedOfSize<sizeof(T)>::type;
+
+        inline void appendLittleEndian(std::vector<unsigned char> &out, uint64_t value, size_t bytes)
+        {
+            for (size_t i = 0; i < bytes; ++i)
+            {
+                out.push_back(static_cast<unsigned char>(value >> (8 * i)));
+            }
+        }
+
+        inline uint64_t readLittleEndian(const unsigned char *in, size_t bytes)
+        {
+            uint64_t value = 0;
+            for (size_t i = 0; i < bytes; ++i)
+            {
+                value |= static_cast<uint64_t>(in[i]) << (8 * i);
+            }
+            return value;
+        }
+
+        // LSB-first bit stream into a byte vector
+        class BitWriter
+        {
+        public:
+            explicit BitWriter(std::vector<unsigned char> &out) : out_(out), buffer_(0), filled_(0) {}
+
+            void write(uint64_t value, unsigned bits)
+            {
+                if (bits == 0)
+                {
+                    return;
+                }
+                if (bits < 64)
+                {
+                    value &= (uint64_t(1) << bits) - 1;
+                }
+
+                buffer_ |= value << filled_;
+                if (filled_ + bits >= 64)
+                {
+                    appendLittleEndian(out_, buffer_, 8);
+                    buffer_ = filled_ == 0 ? 0 : value >> (64 - filled_);
+                    filled_ = filled_ + bits - 64;
+                }
+                else
+                {
+                    filled_ += bits;
+                }
+            }
+
+            void flush()
+            {
+                appendLittleEndian(out_, buffer_, (filled_ + 7) / 8);
+                buffer_ = 0;
+                filled_ = 0;
+            }
+
+        private:
+            std::vector<unsigned char> &out_;
+            uint64_t buffer_;
+            unsigned filled_;
+        };
+
+        class BitReader
+        {
+        public:
+            BitReader(const unsigned char *data, size_t size) : data_(data), end_(data + size), buffer_(0), available_(0) {}
+
+            uint64_t read(unsigned bits)
+            {
+                uint64_t result = 0;
+                unsigned got = 0;
+                while (got < bits)
+                {
+                    if (available_ == 0)
+                    {
+                        refill();
+                    }
+                    const unsigned take = std::min(bits - got, available_);
+                    const uint64_t mask = take == 64 ? ~uint64_t(0) : (uint64_t(1) << take) - 1;
+                    result |= (buffer_ & mask) << got;
+                    buffer_ = take == 64 ? 0 : buffer_ >> take;
+                    available_ -= take;
+                    got += take;
+                }
+                return result;
+            }
+
+            bool readBit()
+            {
+                return read(1) != 0;
+            }
+
+        private:
+            void refill()
+            {
+                const size_t bytes = std::min<size_t>(8, static_cast<size_t>(end_ - data_));
+                if (bytes == 0)
+                {
+                    throw std::runtime_error("Truncated encoded block");
+                }
+                buffer_ = readLittleEndian(data_, bytes);
+                data_ += bytes;
+                available_ = static_cast<unsigned>(8 * bytes);
+            }
+
+            const unsigned char *data_;
+            const unsigned char *end_;
+            uint64_t buffer_;
+            unsigned available_;
+        };
+
+        inline unsigned bitWidth(uint64_t value)
+        {
+            return value == 0 ? 0 : 64 - static_cast<unsigned>(__builtin_clzll(value));
+        }
+
+        template <typename Bits>
+        uint64_t zigzag(Bits value)
+        {
+            using Signed = std::make_signed_t<Bits>;
+            const int64_t signed_value = static_cast<Signed>(value);
+            return (static_cast<uint64_t>(signed_value) << 1) ^ static_cast<uint64_t>(signed_value >> 63);
+        }
+
+        template <typename Bits>
+        Bits unzigzag(uint64_t value)
+        {
+            return static_cast<Bits>((value >> 1) ^ (~(value & 1) + 1));
+        }
+
+        // Block layout: first bit pattern, zigzag first delta, one byte bit
+        // width, then the zigzag second differences at that width
+        template <typename T>
+        void encodeDeltaOfDeltaBlock(const T *data, size_t count, std::vector<unsigned char> &out)
+        {
+            using Bits = BitsOf<T>;
+            std::vector<Bits> bits(count);
+            std::memcpy(bits.data(), data, count * sizeof(T));
+
+            appendLittleEndian(out, bits[0], sizeof(Bits));
+            if (count == 1)
+            {
+                return;
+            }
+
+            Bits previous_delta = static_cast<Bits>(bits[1] - bits[0]);
+            appendLittleEndian(out, zigzag<Bits>(previous_delta), 8);
+
+            std::vector<uint64_t> residuals(count - 2);
+            uint64_t combined = 0;
+            for (size_t i = 2; i < count; ++i)
+            {
+                const Bits delta = static_cast<Bits>(bits[i] - bits[i - 1]);
+                residuals[i - 2] = zigzag<Bits>(static_cast<Bits>(delta - previous_delta));
+                combined |= residuals[i - 2];
+                previous_delta = delta;
+            }
+
+            const unsigned width = bitWidth(combined);
+            out.push_back(static_cast<unsigned char>(width));
+            BitWriter writer(out);
+            for (uint64_t residual : residuals)
+            {
+                writer.write(residual, width);
+            }
+            writer.flush();
+        }
+
+        template <typename T>
+        void decodeDeltaOfDeltaBlock(const unsigned char *in, size_t size, size_t count, T *out)
+        {
+            using Bits = BitsOf<T>;
+            const size_t fixed = sizeof(Bits) + (count > 1 ? 9 : 0);
+            if (size < fixed)
+            {
+                throw std::runtime_error("Truncated encoded block");
+            }
+
+            Bits value = static_cast<Bits>(readLittleEndian(in, sizeof(Bits)));
+            std::memcpy(&out[0], &value, sizeof(T));
+            if (count == 1)
+            {
+                return;
+            }
+
+            Bits delta = unzigzag<Bits>(readLittleEndian(in + sizeof(Bits), 8));
+            value = static_cast<Bits>(value + delta);
+            std::memcpy(&out[1], &value, sizeof(T));
+
+            const unsigned width = in[sizeof(Bits) + 8];
+            if (width > 64)
+            {
+                throw std::runtime_error("Corrupt encoded block");
+            }
+            BitReader reader(in + fixed, size - fixed);
+            for (size_t i = 2; i < count; ++i)
+            {
+                delta = static_cast<Bits>(delta + unzigzag<Bits>(width == 0 ? 0 : reader.read(width)));
+                value = static_cast<Bits>(value + delta);
+                std::memcpy(&out[i], &value, sizeof(T));
+            }
+        }
+
+        // Gorilla control codes per value after the first: 0 for a repeat,
+        // 10 for meaningful bits inside the previous window, 11 followed by
+        // 5 bits of leading zeros and the meaningful bit count minus one
+        template <typename T>
+        void encodeXorBlock(const T *data, size_t count, std::vector<unsigned char> &out)
+        {
+            using Bits = BitsOf<T>;
+            constexpr unsigned kBits = 8 * sizeof(Bits);
+            constexpr unsigned kLengthBits = kBits == 64 ? 6 : 5;
+
+            BitWriter writer(out);
+            Bits previous;
+            std::memcpy(&previous, &data[0], sizeof(T));
+            writer.write(previous, kBits);
+
+            unsigned window_leading = kBits + 1;
+            unsigned window_trailing = 0;
+            for (size_t i = 1; i < count; ++i)
+            {
+                Bits current;
+                std::memcpy(&current, &data[i], sizeof(T));
+                const Bits x = static_cast<Bits>(current ^ previous);
+                previous = current;
+
+                if (x == 0)
+                {
+                    writer.write(0, 1);
+                    continue;
+                }
+
+                const unsigned leading = std::min(31u, static_cast<unsigned>(__builtin_clzll(x)) - (64 - kBits));
+                const unsigned trailing = static_cast<unsigned>(__builtin_ctzll(x));
+
+                if (window_leading <= kBits && leading >= window_leading && trailing >= window_trailing)
+                {
+                    writer.write(1, 1);
+                    writer.write(0, 1);
+                    writer.write(static_cast<uint64_t>(x) >> window_trailing, kBits - window_leading - window_trailing);
+                }
+                else
+                {
+                    const unsigned length = kBits - leading - trailing;
+                    writer.write(1, 1);
+                    writer.write(1, 1);
+                    writer.write(leading, 5);
+                    writer.write(length - 1, kLengthBits);
+                    writer.write(static_cast<uint64_t>(x) >> trailing, length);
+                    window_leading = leading;
+                    window_trailing = trailing;
+                }
+            }
+            writer.flush();
+        }
+
+        template <typename T>
+        void decodeXorBlock(const unsigned char *in, size_t size, size_t count, T *out)
+        {
+            using Bits = BitsOf<T>;
+            constexpr unsigned kBits = 8 * sizeof(Bits);
+            constexpr unsigned kLengthBits = kBits == 64 ? 6 : 5;
+
+            BitReader reader(in, size);
+            Bits value = static_cast<Bits>(reader.read(kBits));
+            std::memcpy(&out[0], &value, sizeof(T));
+
+            unsigned window_leading = 0;
+            unsigned window_trailing = 0;
+            for (size_t i = 1; i < count; ++i)
+            {
+                if (reader.readBit())
+                {
+                    if (reader.readBit())
+                    {
+                        window_leading = static_cast<unsigned>(reader.read(5));
+                        const unsigned length = static_cast<unsigned>(reader.read(kLengthBits)) + 1;
+                        if (window_leading + length > kBits)
+                        {
+                            throw std::runtime_error("Corrupt encoded block");
+                        }
+                        window_trailing = kBits - window_leading - length;
+                    }
+                    const unsigned length = kBits - window_leading - window_trailing;
+                    value = static_cast<Bits>(value ^ static_cast<Bits>(reader.read(length) << window_trailing));
+                }
+                std::memcpy(&out[i], &value, sizeof(T));
+            }
+        }
+    }
+
+    // Encodes count elements as a block stream:
+    //   uint64 block count, uint64 block end offsets, blocks
+    // Offsets are relative to the start of the stream, all little endian.
+    template <typename T>
+    std::vector<unsigned char> encodeBlocks(const T *data, size_t count, ContainerEncoding encoding)
+    {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "Type T must be trivially copyable for encoding");
+
+        if (encoding == ContainerEncoding::XorFloat && sizeof(T) != 4 && sizeof(T) != 8)
+        {
+            throw std::invalid_argument("XorFloat encoding requires 32 or 64 bit elements");
+        }
+
+        std::vector<unsigned char> out;
+        if (encoding == ContainerEncoding::Raw)
+        {
+            out.resize(count * sizeof(T));
+            if (count > 0)
+            {
+                std::memcpy(out.data(), data, out.size());
+            }
+            return out;
+        }
+
+        const size_t block_count = (count + kCodecBlockSize - 1) / kCodecBlockSize;
+        detail::appendLittleEndian(out, block_count, 8);
+        out.resize(out.size() + 8 * block_count);
+
+        for (size_t b = 0; b < block_count; ++b)
+        {
+            const T *block = data + b * kCodecBlockSize;
+            const size_t block_size = std::min(kCodecBlockSize, count - b * kCodecBlockSize);
+            if (encoding == ContainerEncoding::DeltaOfDelta)
+            {
+                detail::encodeDeltaOfDeltaBlock(block, block_size, out);
+            }
+            else if constexpr (sizeof(T) == 4 || sizeof(T) == 8)
+            {
+                detail::encodeXorBlock(block, block_size, out);
+            }
+
+            const uint64_t end = out.size();
+            for (size_t i = 0; i < 8; ++i)
+            {
+                out[8 + 8 * b + i] = static_cast<unsigned char>(end >> (8 * i));
+            }
+        }
+
+        return out;
+    }
+
+    template <typename T>
+    std::vector<unsigned char> encodeBlocks(const std::vector<T> &data, ContainerEncoding encoding)
+    {
+        return encodeBlocks(data.data(), data.size(), encoding);
+    }
+
+    // Decodes a block stream one block at a time, so a consumer such as a
+    // CheckSet or an online checker can run on a kCodecBlockSize buffer
+    // instead of the whole channel.
+    //
+    //   BlockDecoder<double> decoder(payload, payload_size, element_count, ContainerEncoding::XorFloat);
+    //   std::vector<double> block(kCodecBlockSize);
+    //   for (size_t b = 0; b < decoder.blockCount(); ++b)
+    //   {
+    //       size_t n = decoder.decodeBlock(b, block.data());
+    //       ...
+    //   }
+    template <typename T>
+    class BlockDecoder
+    {
+    public:
+        BlockDecoder(const unsigned char *payload, size_t payload_size, size_t element_count, ContainerEncoding encoding)
+            : payload_(payload), payload_size_(payload_size), element_count_(element_count), encoding_(encoding)
+        {
+            static_assert(std::is_trivially_copyable_v<T>,
+                          "Type T must be trivially copyable for decoding");
+
+            if (encoding_ == ContainerEncoding::XorFloat && sizeof(T) != 4 && sizeof(T) != 8)
+            {
+                throw std::invalid_argument("XorFloat encoding requires 32 or 64 bit elements");
+            }
+
+            block_count_ = (element_count + kCodecBlockSize - 1) / kCodecBlockSize;
+            if (encoding_ == ContainerEncoding::Raw)
+            {
+                if (payload_size != element_count * sizeof(T))
+                {
+                    throw std::runtime_error("Corrupt raw payload");
+                }
+                return;
+            }
+
+            if (payload_size < 8 || detail::readLittleEndian(payload, 8) != block_count_ ||
+                payload_size < 8 + 8 * block_count_)
+            {
+                throw std::runtime_error("Corrupt encoded payload");
+            }
+        }
+
+        size_t size() const { return element_count_; }
+        size_t blockCount() const { return block_count_; }
+
+        size_t blockSize(size_t block) const
+        {
+            return std::min(kCodecBlockSize, element_count_ - block * kCodecBlockSize);
+        }
+
+        // Decodes block `block` into out, which must hold kCodecBlockSize
+        // elements, and returns the number of elements written
+        size_t decodeBlock(size_t block, T *out) const
+        {
+            if (block >= block_count_)
+            {
+                throw std::out_of_range("Block index out of range");
+            }
+
+            const size_t count = blockSize(block);
+            if (encoding_ == ContainerEncoding::Raw)
+            {
+                std::memcpy(out, payload_ + block * kCodecBlockSize * sizeof(T), count * sizeof(T));
+                return count;
+            }
+
+            const size_t table = 8;
+            const size_t begin = block == 0 ? table + 8 * block_count_
+                                            : detail::readLittleEndian(payload_ + table + 8 * (block - 1), 8);
+            const size_t end = detail::readLittleEndian(payload_ + table + 8 * block, 8);
+            if (begin > end || end > payload_size_)
+            {
+                throw std::runtime_error("Corrupt encoded payload");
+            }
+
+            if (encoding_ == ContainerEncoding::DeltaOfDelta)
+            {
+                detail::decodeDeltaOfDeltaBlock(payload_ + begin, end - begin, count, out);
+            }
+            else if constexpr (sizeof(T) == 4 || sizeof(T) == 8)
+            {
+                detail::decodeXorBlock(payload_ + begin, end - begin, count, out);
+            }
+            return count;
+        }
+
+        std::vector<T> decodeAll() const
+        {
+            std::vector<T> result(element_count_);
+            for (size_t b = 0; b < block_count_; ++b)
+            {
+                decodeBlock(b, result.data() + b * kCodecBlockSize);
+            }
+            return result;
+        }
+
+    private:
+        const unsigned char *payload_;
+        size_t payload_size_;
+        size_t element_count_;
+        ContainerEncoding encoding_;
+        size_t block_count_;
+    };
+
+}
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <vector>
+#include <type_traits>
+#include <stdexcept>
+#include <numeric>
+#include <cmath>
+
+#include "reference_testing/ranges.h"
+#include "reference_testing/interpolation.h"
+#include "reference_testing/bounds_checker.h"
+
+namespace lumos
+{
+
+  // Reference data prepared once for checking many test runs against it.
+  // Everything that depends only on the reference is computed up front: the
+  // mean and whether the timebase is sorted.
+  //
+  // Contiguous ranges such as std::vector, MappedVector or a container view
+  // are referenced, not copied, and must outlive the CompiledReference, so a
+  // mapped multi-GB reference stays mapped rather than resident twice. An
+  // rvalue std::vector is moved in and owned, and other ranges such as
+  // StridedSpan are copied into owned storage.
+  //
+  // A CompiledReference is itself a contiguous range over the reference
+  // values, so every checker accepts it wherever it accepts a reference or
+  // bound vector. The overloads below additionally use the cached data. For
+  // corridors, Corridor2D is the compiled form of the boundary polylines.
+  template <typename T>
+  class CompiledReference
+  {
+  public:
+    using value_type = T;
+    using const_iterator = const T *;
+
+    template <typename Range,
+              typename = std::enable_if_t<!std::is_same_v<std::decay_t<Range>, CompiledReference>>>
+    explicit CompiledReference(Range &&values)
+        : time_sorted_(false)
+    {
+      static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                    "CompiledReference only supports float and double types");
+      static_assert(std::is_same_v<T, RangeValueType<std::decay_t<Range>>>,
+                    "CompiledReference requires a range of its value type");
+      values_ = adopt(std::forward<Range>(values), owned_values_);
+      compile();
+    }
+
+    template <typename TimeRange, typename Range>
+    CompiledReference(TimeRange &&time, Range &&values)
+        : CompiledReference(std::forward<Range>(values))
+    {
+      static_assert(std::is_same_v<T, RangeValueType<std::decay_t<TimeRange>>>,
+                    "CompiledReference requires a timebase of its value type");
+      if (time.size() != values_.size())
+      {
+        throw std::invalid_argument("Time and value vectors must have the same size");
+      }
+
+      time_ = adopt(std::forward<TimeRange>(time), owned_time_);
+      time_sorted_ = isSortedTimeVector(time_);
+    }
+
+    // Views may point into owned storage, which a copy would not carry over
+    CompiledReference(const CompiledReference &) = delete;
+    CompiledReference &operator=(const CompiledReference &) = delete;
+    CompiledReference(CompiledReference &&) = default;
+    CompiledReference &operator=(CompiledReference &&) = default;
+
+    const T *data() const { return values_.data(); }
+    size_t size() const { return values_.size(); }
+    bool empty() const { return values_.empty(); }
+    const T &operator[](size_t index) const { return values_[index]; }
+    const_iterator begin() const { return values_.begin(); }
+    const_iterator end() const { return values_.end(); }
+
+    Span<const T> values() const { return values_; }
+    Span<const T> time() const { return time_; }
+    bool hasTime() const { return !time_.empty() || values_.empty(); }
+    bool isTimeSorted() const { return time_sorted_; }
+
+    // Accumulated in the same order as isMeanDifferenceWithinThreshold
+    T mean() const { return mean_; }
+
+  private:
+    template <typename Range>
+    static Span<const T> adopt(Range &&range, std::vector<T> &storage)
+    {
+      using R = std::decay_t<Range>;
+      if constexpr (std::is_same_v<R, std::vector<T>> && !std::is_lvalue_reference_v<Range>)
+      {
+        storage = std::move(range);
+      }
+      else if constexpr (IsContiguousRange<R>::value)
+      {
+        return Span<const T>(range.data(), range.size());
+      }
+      else
+      {
+        storage.assign(range.begin(), range.end());
+      }
+      return Span<const T>(storage.data(), storage.size());
+    }
+
+    void compile()
+    {
+      mean_ = values_.empty() ? T(0)
+                              : std::accumulate(values_.begin(), values_.end(), T(0)) /
+                                    static_cast<T>(values_.size());
+    }
+
+    std::vector<T> owned_values_;
+    std::vector<T> owned_time_;
+    Span<const T> values_;
+    Span<const T> time_;
+    T mean_;
+    bool time_sorted_;
+  };
+
+  template <typename TestRange, typename T>
+  bool isMeanDifferenceWithinThreshold(const TestRange &test_vector,
+                                       const CompiledReference<T> &reference,
+                                       RangeValueType<TestRange> threshold)
+  {
+    static_assert(std::is_same_v<T, RangeValueType<TestRange>>,
+                  "isMeanDifferenceWithinThreshold requires test and reference ranges of the same value type");
+
+    if (test_vector.size() != reference.size())
+    {
+      return false;
+    }
+
+    if (test_vector.empty())
+    {
+      return true;
+    }
+
+    T test_mean = std::accumulate(test_vector.begin(), test_vector.end(), T(0)) /
+                  static_cast<T>(test_vector.size());
+
+    T mean_diff = std::abs(test_mean - reference.mean());
+    return mean_diff <= threshold;
+  }
+
+  // Time-based bounds check against compiled bounds that carry their own
+  // timebase; sortedness of the bound timebases is not re-scanned per call
+  template <typename TestRange, typename T>
+  bool isWithinBounds(const TestRange &test_vector_time,
+                      const TestRange &test_vector,
+                      const CompiledReference<T> &min_bounds,
+                      const CompiledReference<T> &max_bounds)
+  {
+    static_assert(std::is_same_v<T, RangeValueType<TestRange>>,
+                  "isWithinBounds requires test and bound ranges of the same value type");
+
+    if (!min_bounds.hasTime() || !max_bounds.hasTime())
+    {
+      throw std::invalid_argument("Compiled bounds must have a timebase");
+    }
+
+    if (test_vector_time.size() != test_vector.size())
+    {
+      return false;
+    }
+
+    if (test_vector.empty())
+    {
+      return true;
+    }
+
+    return detail::isWithinTimeBounds(test_vector_time, test_vector,
+                                      min_bounds.time(), min_bounds.values(),
+                                      max_bounds.time(), max_bounds.values(),
+                                      min_bounds.isTimeSorted() && max_bounds.isTimeSorted());
+  }
+
+}
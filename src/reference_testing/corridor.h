@@ -0,0 +1,214 @@
+#pragma once
+
+#include <vector>
+#include <type_traits>
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+
+#include "reference_testing/ranges.h"
+
+namespace lumos
+{
+
+  // A 2D corridor between a left and a right boundary polyline, indexed once
+  // so that many test trajectories can be checked against it cheaply.
+  //
+  // The corridor is the closed polygon left[0] ... left[L-1], right[R-1] ...
+  // right[0], so curved and non-convex corridors are handled exactly and the
+  // ends are capped by the segments joining the boundary end points. Points
+  // on the boundary count as inside.
+  //
+  // The polygon edges are bucketed into uniform slabs along the longer axis of
+  // the bounding box. A point query only visits the edges of its own slab: it
+  // checks whether the point lies on one of them and otherwise counts the
+  // crossings of a ray cast across the slab.
+  template <typename T>
+  class Corridor2D
+  {
+  public:
+    template <typename BoundaryRange>
+    Corridor2D(const BoundaryRange &x_left, const BoundaryRange &y_left,
+               const BoundaryRange &x_right, const BoundaryRange &y_right)
+    {
+      static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                    "Corridor2D only supports float and double types");
+      static_assert(std::is_same_v<T, RangeValueType<BoundaryRange>>,
+                    "Corridor2D requires boundary ranges of its value type");
+
+      if (x_left.size() != y_left.size() || x_right.size() != y_right.size())
+      {
+        throw std::invalid_argument("Boundary vectors must have consistent sizes");
+      }
+
+      if (x_left.size() < 2 || x_right.size() < 2)
+      {
+        throw std::invalid_argument("Boundary vectors must have at least 2 points");
+      }
+
+      std::vector<T> polygon_x, polygon_y;
+      polygon_x.reserve(x_left.size() + x_right.size());
+      polygon_y.reserve(x_left.size() + x_right.size());
+      for (size_t i = 0; i < x_left.size(); ++i)
+      {
+        polygon_x.push_back(x_left[i]);
+        polygon_y.push_back(y_left[i]);
+      }
+      for (size_t i = x_right.size(); i-- > 0;)
+      {
+        polygon_x.push_back(x_right[i]);
+        polygon_y.push_back(y_right[i]);
+      }
+
+      const auto [min_x, max_x] = std::minmax_element(polygon_x.begin(), polygon_x.end());
+      const auto [min_y, max_y] = std::minmax_element(polygon_y.begin(), polygon_y.end());
+
+      // Slabs partition u, the axis with the larger extent; v is the other one
+      swap_axes_ = (*max_y - *min_y) > (*max_x - *min_x);
+      const std::vector<T> &u = swap_axes_ ? polygon_y : polygon_x;
+      const std::vector<T> &v = swap_axes_ ? polygon_x : polygon_y;
+      min_u_ = swap_axes_ ? *min_y : *min_x;
+      max_u_ = swap_axes_ ? *max_y : *max_x;
+      min_v_ = swap_axes_ ? *min_x : *min_y;
+      max_v_ = swap_axes_ ? *max_x : *max_y;
+
+      const size_t edge_count = u.size();
+      edges_.reserve(edge_count);
+      for (size_t i = 0; i < edge_count; ++i)
+      {
+        const size_t j = (i + 1) % edge_count;
+        edges_.push_back(Edge{u[i], v[i], u[j], v[j]});
+      }
+
+      slab_count_ = std::max<size_t>(1, std::min<size_t>(edge_count, kMaxSlabs));
+      const T extent = max_u_ - min_u_;
+      slab_scale_ = extent > T(0) ? static_cast<T>(slab_count_) / extent : T(0);
+
+      // Bucket the edge indices by slab in CSR layout
+      slab_offsets_.assign(slab_count_ + 1, 0);
+      for (const Edge &edge : edges_)
+      {
+        const auto [first, last] = slabRange(edge);
+        for (size_t s = first; s <= last; ++s)
+        {
+          slab_offsets_[s + 1]++;
+        }
+      }
+      for (size_t s = 0; s < slab_count_; ++s)
+      {
+        slab_offsets_[s + 1] += slab_offsets_[s];
+      }
+      slab_edges_.resize(slab_offsets_[slab_count_]);
+      std::vector<size_t> fill(slab_offsets_.begin(), slab_offsets_.end() - 1);
+      for (size_t e = 0; e < edges_.size(); ++e)
+      {
+        const auto [first, last] = slabRange(edges_[e]);
+        for (size_t s = first; s <= last; ++s)
+        {
+          slab_edges_[fill[s]++] = e;
+        }
+      }
+    }
+
+    bool contains(T x, T y) const
+    {
+      const T pu = swap_axes_ ? y : x;
+      const T pv = swap_axes_ ? x : y;
+
+      if (!(pu >= min_u_ && pu <= max_u_ && pv >= min_v_ && pv <= max_v_))
+      {
+        return false;
+      }
+
+      const size_t slab = slabIndex(pu);
+      bool inside = false;
+      for (size_t k = slab_offsets_[slab]; k < slab_offsets_[slab + 1]; ++k)
+      {
+        const Edge &edge = edges_[slab_edges_[k]];
+
+        if (isOnEdge(edge, pu, pv))
+        {
+          return true;
+        }
+
+        // Crossing of the ray from (pu, pv) towards +v, half-open in u
+        if ((edge.u1 > pu) != (edge.u2 > pu))
+        {
+          const T v_at = edge.v1 + (pu - edge.u1) * (edge.v2 - edge.v1) / (edge.u2 - edge.u1);
+          if (v_at > pv)
+          {
+            inside = !inside;
+          }
+        }
+      }
+
+      return inside;
+    }
+
+    // Index of the first test point outside the corridor, or the number of points
+    template <typename TestRange>
+    size_t findFirstOutside(const TestRange &x_test, const TestRange &y_test) const
+    {
+      if (x_test.size() != y_test.size())
+      {
+        throw std::invalid_argument("Test vectors must have the same size");
+      }
+
+      for (size_t i = 0; i < x_test.size(); ++i)
+      {
+        if (!contains(x_test[i], y_test[i]))
+        {
+          return i;
+        }
+      }
+
+      return x_test.size();
+    }
+
+  private:
+    static constexpr size_t kMaxSlabs = size_t(1) << 16;
+
+    struct Edge
+    {
+      T u1, v1, u2, v2;
+    };
+
+    size_t slabIndex(T u) const
+    {
+      const T scaled = (u - min_u_) * slab_scale_;
+      if (!(scaled > T(0)))
+        return 0;
+      return std::min(static_cast<size_t>(scaled), slab_count_ - 1);
+    }
+
+    std::pair<size_t, size_t> slabRange(const Edge &edge) const
+    {
+      return {slabIndex(std::min(edge.u1, edge.u2)), slabIndex(std::max(edge.u1, edge.u2))};
+    }
+
+    static bool isOnEdge(const Edge &edge, T pu, T pv)
+    {
+      const T cross = (edge.u2 - edge.u1) * (pv - edge.v1) - (edge.v2 - edge.v1) * (pu - edge.u1);
+      return cross == T(0) &&
+             pu >= std::min(edge.u1, edge.u2) && pu <= std::max(edge.u1, edge.u2) &&
+             pv >= std::min(edge.v1, edge.v2) && pv <= std::max(edge.v1, edge.v2);
+    }
+
+    bool swap_axes_;
+    T min_u_, max_u_, min_v_, max_v_;
+    T slab_scale_;
+    size_t slab_count_;
+    std::vector<Edge> edges_;
+    std::vector<size_t> slab_offsets_;
+    std::vector<size_t> slab_edges_;
+  };
+
+  template <typename TestRange, typename T>
+  bool isWithin2DCorridor(const TestRange &x_test, const TestRange &y_test, const Corridor2D<T> &corridor)
+  {
+    static_assert(std::is_same_v<T, RangeValueType<TestRange>>,
+                  "isWithin2DCorridor requires test ranges of the corridor's value type");
+    return corridor.findFirstOutside(x_test, y_test) == x_test.size();
+  }
+
+}
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <type_traits>
+#include <stdexcept>
+#include <limits>
+#include <cmath>
+#include <cstddef>
+
+#include "reference_testing/ranges.h"
+#include "reference_testing/online_checkers.h"
+
+namespace lumos
+{
+
+  // Duration-based counterparts of the consecutive-sample checks for
+  // irregularly sampled signals. Run lengths are measured on the timestamps
+  // directly, without resampling to a uniform grid.
+  //
+  // Samples are taken to hold their value until the next sample (zero-order
+  // hold), so a run lasts from the first sample that meets the condition to
+  // the first one that does not. A run still going at the last sample ends at
+  // that sample's time. On a uniform grid with step dt, N consecutive samples
+  // followed by a failing one make a run of N * dt.
+
+  // Time span of a run, both NaN while no sample met the condition
+  template <typename T>
+  struct TimeRun
+  {
+    T start;
+    T end;
+
+    T duration() const { return std::isnan(start) ? T(0) : end - start; }
+  };
+
+  template <typename T, typename Predicate>
+  class OnlineDurationWithConditionTrue
+  {
+  public:
+    // end_time is when the recording is known to end; if given, the check
+    // fails early once the remaining time cannot complete a run
+    OnlineDurationWithConditionTrue(Predicate condition, T min_duration,
+                                    T end_time = std::numeric_limits<T>::infinity())
+        : condition_(condition), min_duration_(min_duration), end_time_(end_time), samples_seen_(0),
+          last_time_(T(0)), in_run_(false), run_start_(T(0)),
+          longest_run_{std::numeric_limits<T>::quiet_NaN(), std::numeric_limits<T>::quiet_NaN()}
+    {
+      static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                    "OnlineDurationWithConditionTrue only supports float and double types");
+    }
+
+    void push(T time, T sample)
+    {
+      if (isDecided())
+        return;
+
+      if (samples_seen_ > 0 && time < last_time_)
+      {
+        throw std::invalid_argument("Timestamps must be non-decreasing");
+      }
+
+      // The run held up to this sample regardless of its value
+      if (in_run_)
+      {
+        extendLongest(time);
+      }
+
+      ++samples_seen_;
+      last_time_ = time;
+      if (condition_(sample))
+      {
+        if (!in_run_)
+        {
+          in_run_ = true;
+          run_start_ = time;
+          extendLongest(time);
+        }
+      }
+      else
+      {
+        in_run_ = false;
+      }
+    }
+
+    template <typename TimeRange, typename Range, typename = EnableIfRange<Range>>
+    void push(const TimeRange &times, const Range &samples)
+    {
+      if (times.size() != samples.size())
+      {
+        throw std::invalid_argument("Timestamps and samples must have the same size");
+      }
+
+      for (size_t i = 0; i < samples.size() && !isDecided(); ++i)
+      {
+        push(times[i], samples[i]);
+      }
+    }
+
+    bool isDecided() const
+    {
+      if (verdict())
+        return true;
+
+      // Fails early when even an unbroken run until end_time is too short
+      if (samples_seen_ == 0 || std::isinf(end_time_))
+        return false;
+      return end_time_ - (in_run_ ? run_start_ : last_time_) < min_duration_;
+    }
+
+    bool verdict() const
+    {
+      return min_duration_ <= T(0) || longest_run_.duration() >= min_duration_;
+    }
+
+    TimeRun<T> longestRun() const { return longest_run_; }
+    size_t samplesSeen() const { return samples_seen_; }
+
+  private:
+    void extendLongest(T time)
+    {
+      if (std::isnan(longest_run_.start) || time - run_start_ > longest_run_.duration())
+      {
+        longest_run_ = {run_start_, time};
+      }
+    }
+
+    Predicate condition_;
+    T min_duration_;
+    T end_time_;
+    size_t samples_seen_;
+    T last_time_;
+    bool in_run_;
+    T run_start_;
+    TimeRun<T> longest_run_;
+  };
+
+  template <typename T, typename Predicate>
+  OnlineDurationWithConditionTrue<T, Predicate> makeOnlineDurationWithConditionTrue(
+      Predicate condition, T min_duration, T end_time = std::numeric_limits<T>::infinity())
+  {
+    return OnlineDurationWithConditionTrue<T, Predicate>(condition, min_duration, end_time);
+  }
+
+  template <typename T>
+  class OnlineDurationAboveThreshold
+      : public OnlineDurationWithConditionTrue<T, detail::AboveThreshold<T>>
+  {
+  public:
+    OnlineDurationAboveThreshold(T threshold, T min_duration, T end_time = std::numeric_limits<T>::infinity())
+        : OnlineDurationWithConditionTrue<T, detail::AboveThreshold<T>>(
+              detail::AboveThreshold<T>{threshold}, min_duration, end_time)
+    {
+    }
+  };
+
+  template <typename T>
+  class OnlineDurationBelowThreshold
+      : public OnlineDurationWithConditionTrue<T, detail::BelowThreshold<T>>
+  {
+  public:
+    OnlineDurationBelowThreshold(T threshold, T min_duration, T end_time = std::numeric_limits<T>::infinity())
+        : OnlineDurationWithConditionTrue<T, detail::BelowThreshold<T>>(
+              detail::BelowThreshold<T>{threshold}, min_duration, end_time)
+    {
+    }
+  };
+
+  // True if the condition holds for at least min_duration without
+  // interruption. Stops at the first run that is long enough.
+  template <typename TimeRange, typename Range, typename Predicate>
+  bool isConditionTrueForAtLeast(const TimeRange &time, const Range &test_vector,
+                                 Predicate condition, RangeValueType<Range> min_duration)
+  {
+    using T = RangeValueType<Range>;
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                  "isConditionTrueForAtLeast only supports float and double types");
+
+    if (time.size() != test_vector.size())
+    {
+      return false;
+    }
+
+    OnlineDurationWithConditionTrue<T, Predicate> check(condition, min_duration);
+    check.push(time, test_vector);
+    return check.verdict();
+  }
+
+  template <typename TimeRange, typename Range>
+  bool isAboveThresholdForAtLeast(const TimeRange &time, const Range &test_vector,
+                                  RangeValueType<Range> threshold, RangeValueType<Range> min_duration)
+  {
+    return isConditionTrueForAtLeast(time, test_vector, detail::AboveThreshold<RangeValueType<Range>>{threshold},
+                                     min_duration);
+  }
+
+  template <typename TimeRange, typename Range>
+  bool isBelowThresholdForAtLeast(const TimeRange &time, const Range &test_vector,
+                                  RangeValueType<Range> threshold, RangeValueType<Range> min_duration)
+  {
+    return isConditionTrueForAtLeast(time, test_vector, detail::BelowThreshold<RangeValueType<Range>>{threshold},
+                                     min_duration);
+  }
+
+  // Longest uninterrupted run of the condition, in a single pass
+  template <typename TimeRange, typename Range, typename Predicate>
+  TimeRun<RangeValueType<Range>> findLongestRunWithConditionTrue(const TimeRange &time, const Range &test_vector,
+                                                                 Predicate condition)
+  {
+    using T = RangeValueType<Range>;
+    OnlineDurationWithConditionTrue<T, Predicate> check(condition, std::numeric_limits<T>::infinity());
+    check.push(time, test_vector);
+    return check.longestRun();
+  }
+
+  template <typename TimeRange, typename Range>
+  TimeRun<RangeValueType<Range>> findLongestRunAboveThreshold(const TimeRange &time, const Range &test_vector,
+                                                              RangeValueType<Range> threshold)
+  {
+    return findLongestRunWithConditionTrue(time, test_vector, detail::AboveThreshold<RangeValueType<Range>>{threshold});
+  }
+
+  template <typename TimeRange, typename Range>
+  TimeRun<RangeValueType<Range>> findLongestRunBelowThreshold(const TimeRange &time, const Range &test_vector,
+                                                              RangeValueType<Range> threshold)
+  {
+    return findLongestRunWithConditionTrue(time, test_vector, detail::BelowThreshold<RangeValueType<Range>>{threshold});
+  }
+
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <vector>
+#include <type_traits>
+#include <stdexcept>
+#include <algorithm>
+
+#include "reference_testing/ranges.h"
+
+namespace lumos
+{
+
+  template <typename T>
+  T linearInterpolate(T x, T x0, T y0, T x1, T y1)
+  {
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                  "linearInterpolate only supports float and double types");
+    if (x1 == x0)
+      return y0;
+    return y0 + (y1 - y0) * (x - x0) / (x1 - x0);
+  }
+
+  template <typename Range>
+  RangeValueType<Range> interpolateAtTime(RangeValueType<Range> target_time,
+                                          const Range &time_vec,
+                                          const Range &value_vec)
+  {
+    using T = RangeValueType<Range>;
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                  "interpolateAtTime only supports float and double types");
+    if (time_vec.size() != value_vec.size() || time_vec.size() == 0)
+    {
+      throw std::invalid_argument("Time and value vectors must have same non-zero size");
+    }
+
+    const size_t last = time_vec.size() - 1;
+    if (target_time <= time_vec[0])
+      return value_vec[0];
+    if (target_time >= time_vec[last])
+      return value_vec[last];
+
+    for (size_t i = 0; i < last; ++i)
+    {
+      if (target_time >= time_vec[i] && target_time <= time_vec[i + 1])
+      {
+        return linearInterpolate(target_time, time_vec[i], value_vec[i],
+                                 time_vec[i + 1], value_vec[i + 1]);
+      }
+    }
+
+    return value_vec[last];
+  }
+
+  // Evaluates interpolateAtTime for a sequence of query times in amortised
+  // constant time per query. The segment found by the previous query is kept
+  // as a cursor; queries that move forward in time advance the cursor
+  // merge-style, and queries that move backward fall back to a binary search.
+  // Results are identical to interpolateAtTime as long as time_vec is sorted.
+  // The ranges are held as View, a Span by default, so they must outlive
+  // the interpolator; use StridedSpan<const T> for strided data.
+  template <typename T, typename View = Span<const T>>
+  class Interpolator
+  {
+  public:
+    template <typename TimeRange, typename ValueRange>
+    Interpolator(const TimeRange &time_vec, const ValueRange &value_vec)
+        : time_vec_(time_vec), value_vec_(value_vec), size_(time_vec.size()), segment_(0)
+    {
+      static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                    "Interpolator only supports float and double types");
+      static_assert(std::is_same_v<T, RangeValueType<TimeRange>> &&
+                        std::is_same_v<T, RangeValueType<ValueRange>>,
+                    "Interpolator requires time and value ranges of its value type");
+      if (time_vec.size() != value_vec.size() || time_vec.size() == 0)
+      {
+        throw std::invalid_argument("Time and value vectors must have same non-zero size");
+      }
+    }
+
+    T operator()(T target_time)
+    {
+      if (target_time <= time_vec_[0])
+        return value_vec_[0];
+      if (target_time >= time_vec_[size_ - 1])
+        return value_vec_[size_ - 1];
+
+      size_t segment = findSegment(target_time);
+      return linearInterpolate(target_time, time_vec_[segment], value_vec_[segment],
+                               time_vec_[segment + 1], value_vec_[segment + 1]);
+    }
+
+    // Returns the index i of the segment [time_vec[i], time_vec[i + 1]] used
+    // for target_time. Only valid for time_vec[0] < target_time < time_vec.back().
+    size_t findSegment(T target_time)
+    {
+      // Invariant: time_vec_[segment_] < target_time, which makes segment_ the
+      // first index whose right end point is not before target_time.
+      if (time_vec_[segment_] >= target_time)
+      {
+        segment_ = static_cast<size_t>(
+            std::lower_bound(time_vec_.begin() + 1, time_vec_.end(), target_time) - time_vec_.begin() - 1);
+      }
+      else
+      {
+        while (time_vec_[segment_ + 1] < target_time)
+        {
+          ++segment_;
+        }
+      }
+
+      return segment_;
+    }
+
+  private:
+    View time_vec_;
+    View value_vec_;
+    size_t size_;
+    size_t segment_;
+  };
+
+  template <typename Range>
+  bool isSortedTimeVector(const Range &time_vec)
+  {
+    return std::is_sorted(time_vec.begin(), time_vec.end());
+  }
+
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <type_traits>
+#include <stdexcept>
+#include <cstring>
+#include <cstdint>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "reference_testing/binary_serializer.h"
+
+namespace lumos
+{
+
+    // Read-only view of a vector saved with saveBinaryVector, backed by a
+    // memory mapping of the file so the payload is never copied or zeroed.
+    // The header is validated exactly like loadBinaryVector. Files written
+    // before payloads were aligned are copied into an owned buffer instead.
+    template <typename T>
+    class MappedVector
+    {
+    public:
+        using value_type = T;
+        using const_iterator = const T *;
+
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "Type T must be trivially copyable for binary deserialization");
+
+        explicit MappedVector(const std::string &filename)
+        {
+            BinaryHeader header;
+            {
+                std::ifstream file(filename, std::ios::binary);
+                if (!file.is_open())
+                {
+                    throw std::runtime_error("Failed to open file for reading: " + filename);
+                }
+                header = readBinaryHeader<T>(file, filename);
+            }
+
+            const int fd = ::open(filename.c_str(), O_RDONLY);
+            if (fd < 0)
+            {
+                throw std::runtime_error("Failed to open file for reading: " + filename);
+            }
+
+            // Checked without forming payload_offset + element_count * sizeof(T),
+            // which a corrupt header can make wrap around
+            struct stat file_stat;
+            if (::fstat(fd, &file_stat) != 0 ||
+                header.payload_offset > static_cast<size_t>(file_stat.st_size) ||
+                header.element_count > (static_cast<size_t>(file_stat.st_size) - header.payload_offset) / sizeof(T))
+            {
+                ::close(fd);
+                throw std::runtime_error("Error reading from file: " + filename);
+            }
+
+            size_ = header.element_count;
+            if (size_ > 0)
+            {
+                mapping_size_ = static_cast<size_t>(file_stat.st_size);
+                mapping_ = ::mmap(nullptr, mapping_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            }
+            ::close(fd);
+
+            if (mapping_ == MAP_FAILED)
+            {
+                mapping_ = nullptr;
+                throw std::runtime_error("Failed to map file: " + filename);
+            }
+
+            if (mapping_ != nullptr)
+            {
+                const char *payload = static_cast<const char *>(mapping_) + header.payload_offset;
+                if (reinterpret_cast<std::uintptr_t>(payload) % alignof(T) == 0)
+                {
+                    ::madvise(mapping_, mapping_size_, MADV_SEQUENTIAL);
+                    data_ = reinterpret_cast<const T *>(payload);
+                }
+                else
+                {
+                    fallback_.resize(size_);
+                    std::memcpy(fallback_.data(), payload, size_ * sizeof(T));
+                    unmap();
+                    data_ = fallback_.data();
+                }
+            }
+        }
+
+        ~MappedVector()
+        {
+            unmap();
+        }
+
+        MappedVector(const MappedVector &) = delete;
+        MappedVector &operator=(const MappedVector &) = delete;
+
+        MappedVector(MappedVector &&other) noexcept
+        {
+            *this = std::move(other);
+        }
+
+        MappedVector &operator=(MappedVector &&other) noexcept
+        {
+            if (this != &other)
+            {
+                unmap();
+                const bool uses_fallback = other.data_ == other.fallback_.data();
+                mapping_ = other.mapping_;
+                mapping_size_ = other.mapping_size_;
+                size_ = other.size_;
+                fallback_ = std::move(other.fallback_);
+                data_ = uses_fallback ? fallback_.data() : other.data_;
+                other.mapping_ = nullptr;
+                other.mapping_size_ = 0;
+                other.data_ = nullptr;
+                other.size_ = 0;
+            }
+            return *this;
+        }
+
+        const T *data() const { return data_; }
+        size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+
+        const T &operator[](size_t index) const { return data_[index]; }
+        const T &front() const { return data_[0]; }
+        const T &back() const { return data_[size_ - 1]; }
+
+        const_iterator begin() const { return data_; }
+        const_iterator end() const { return data_ + size_; }
+
+        std::vector<T> toVector() const
+        {
+            return std::vector<T>(begin(), end());
+        }
+
+    private:
+        void unmap()
+        {
+            if (mapping_ != nullptr)
+            {
+                ::munmap(mapping_, mapping_size_);
+                mapping_ = nullptr;
+                mapping_size_ = 0;
+            }
+        }
+
+        void *mapping_ = nullptr;
+        size_t mapping_size_ = 0;
+        const T *data_ = nullptr;
+        size_t size_ = 0;
+        std::vector<T> fallback_;
+    };
+
+}
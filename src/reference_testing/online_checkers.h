@@ -0,0 +1,391 @@
+#pragma once
+
+#include <type_traits>
+#include <cmath>
+#include <cstddef>
+
+#include "reference_testing/ranges.h"
+
+namespace lumos
+{
+
+  // Online counterparts of the checkers in bounds_checker.h. Samples are fed
+  // with push() as they arrive, state is O(1), and verdict() returns what the
+  // batch checker would return for all samples pushed so far. isDecided()
+  // becomes true as soon as no further sample can change the verdict, after
+  // which push() is a no-op.
+  //
+  // Checks whose outcome depends on the total run length can only fail early
+  // if that length is known; pass it as expected_samples (0 means unknown).
+
+  template <typename T>
+  class OnlineWithinBounds
+  {
+  public:
+    OnlineWithinBounds() : samples_seen_(0), within_bounds_(true)
+    {
+      static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                    "OnlineWithinBounds only supports float and double types");
+    }
+
+    void push(T test_value, T min_bound, T max_bound)
+    {
+      if (isDecided())
+        return;
+
+      ++samples_seen_;
+      if (test_value < min_bound || test_value > max_bound)
+      {
+        within_bounds_ = false;
+      }
+    }
+
+    template <typename TestRange, typename BoundRange, typename = EnableIfRange<TestRange>>
+    void push(const TestRange &test_values, const BoundRange &min_bounds, const BoundRange &max_bounds)
+    {
+      if (test_values.size() != min_bounds.size() || test_values.size() != max_bounds.size())
+      {
+        within_bounds_ = false;
+        return;
+      }
+
+      for (size_t i = 0; i < test_values.size() && !isDecided(); ++i)
+      {
+        push(test_values[i], min_bounds[i], max_bounds[i]);
+      }
+    }
+
+    bool isDecided() const { return !within_bounds_; }
+    bool verdict() const { return within_bounds_; }
+    size_t samplesSeen() const { return samples_seen_; }
+
+  private:
+    size_t samples_seen_;
+    bool within_bounds_;
+  };
+
+  template <typename T>
+  class OnlineVarianceWithinThreshold
+  {
+  public:
+    OnlineVarianceWithinThreshold(T threshold, size_t expected_samples = 0)
+        : threshold_(threshold), expected_samples_(expected_samples),
+          samples_seen_(0), mean_squared_diff_(T(0)), size_mismatch_(false)
+    {
+      static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                    "OnlineVarianceWithinThreshold only supports float and double types");
+    }
+
+    void push(T test_value, T reference_value)
+    {
+      if (isDecided())
+        return;
+
+      // Welford-style running mean of the squared difference
+      const T diff = test_value - reference_value;
+      ++samples_seen_;
+      mean_squared_diff_ += (diff * diff - mean_squared_diff_) / static_cast<T>(samples_seen_);
+    }
+
+    template <typename TestRange, typename ReferenceRange, typename = EnableIfRange<TestRange>>
+    void push(const TestRange &test_values, const ReferenceRange &reference_values)
+    {
+      if (test_values.size() != reference_values.size())
+      {
+        size_mismatch_ = true;
+        return;
+      }
+
+      for (size_t i = 0; i < test_values.size() && !isDecided(); ++i)
+      {
+        push(test_values[i], reference_values[i]);
+      }
+    }
+
+    bool isDecided() const
+    {
+      if (size_mismatch_)
+        return true;
+
+      // The sum of squared differences never decreases, so once it exceeds
+      // what the expected run length allows the check has failed. Past the
+      // expected length that bound no longer holds.
+      return expected_samples_ > 0 && samples_seen_ <= expected_samples_ &&
+             mean_squared_diff_ * static_cast<T>(samples_seen_) / static_cast<T>(expected_samples_) > threshold_;
+    }
+
+    bool verdict() const
+    {
+      if (size_mismatch_)
+        return false;
+      return mean_squared_diff_ <= threshold_;
+    }
+
+    T variance() const { return mean_squared_diff_; }
+    size_t samplesSeen() const { return samples_seen_; }
+
+  private:
+    T threshold_;
+    size_t expected_samples_;
+    size_t samples_seen_;
+    T mean_squared_diff_;
+    bool size_mismatch_;
+  };
+
+  template <typename T>
+  class OnlineMeanDifferenceWithinThreshold
+  {
+  public:
+    explicit OnlineMeanDifferenceWithinThreshold(T threshold)
+        : threshold_(threshold), samples_seen_(0), test_mean_(T(0)), reference_mean_(T(0)), size_mismatch_(false)
+    {
+      static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                    "OnlineMeanDifferenceWithinThreshold only supports float and double types");
+    }
+
+    void push(T test_value, T reference_value)
+    {
+      if (isDecided())
+        return;
+
+      ++samples_seen_;
+      test_mean_ += (test_value - test_mean_) / static_cast<T>(samples_seen_);
+      reference_mean_ += (reference_value - reference_mean_) / static_cast<T>(samples_seen_);
+    }
+
+    template <typename TestRange, typename ReferenceRange, typename = EnableIfRange<TestRange>>
+    void push(const TestRange &test_values, const ReferenceRange &reference_values)
+    {
+      if (test_values.size() != reference_values.size())
+      {
+        size_mismatch_ = true;
+        return;
+      }
+
+      for (size_t i = 0; i < test_values.size() && !isDecided(); ++i)
+      {
+        push(test_values[i], reference_values[i]);
+      }
+    }
+
+    // A mean can always be pulled back by later samples, so only a size
+    // mismatch decides this check early
+    bool isDecided() const { return size_mismatch_; }
+
+    bool verdict() const
+    {
+      if (size_mismatch_)
+        return false;
+      return std::abs(test_mean_ - reference_mean_) <= threshold_;
+    }
+
+    T meanDifference() const { return std::abs(test_mean_ - reference_mean_); }
+    size_t samplesSeen() const { return samples_seen_; }
+
+  private:
+    T threshold_;
+    size_t samples_seen_;
+    T test_mean_;
+    T reference_mean_;
+    bool size_mismatch_;
+  };
+
+  template <typename T, typename Predicate>
+  class OnlineSamplesWithConditionTrue
+  {
+  public:
+    OnlineSamplesWithConditionTrue(Predicate condition, size_t min_samples, size_t expected_samples = 0)
+        : condition_(condition), min_samples_(min_samples), expected_samples_(expected_samples),
+          samples_seen_(0), count_(0)
+    {
+      static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                    "OnlineSamplesWithConditionTrue only supports float and double types");
+    }
+
+    void push(T sample)
+    {
+      if (isDecided())
+        return;
+
+      ++samples_seen_;
+      if (condition_(sample))
+      {
+        count_++;
+      }
+    }
+
+    template <typename Range, typename = EnableIfRange<Range>>
+    void push(const Range &samples)
+    {
+      for (size_t i = 0; i < samples.size() && !isDecided(); ++i)
+      {
+        push(samples[i]);
+      }
+    }
+
+    bool isDecided() const
+    {
+      if (count_ >= min_samples_)
+        return true;
+
+      // Fails early when the remaining samples cannot reach min_samples
+      return expected_samples_ > 0 && samples_seen_ <= expected_samples_ &&
+             count_ + (expected_samples_ - samples_seen_) < min_samples_;
+    }
+
+    bool verdict() const { return count_ >= min_samples_; }
+    size_t count() const { return count_; }
+    size_t samplesSeen() const { return samples_seen_; }
+
+  private:
+    Predicate condition_;
+    size_t min_samples_;
+    size_t expected_samples_;
+    size_t samples_seen_;
+    size_t count_;
+  };
+
+  template <typename T, typename Predicate>
+  class OnlineConsecutiveSamplesWithConditionTrue
+  {
+  public:
+    OnlineConsecutiveSamplesWithConditionTrue(Predicate condition, size_t min_consecutive, size_t expected_samples = 0)
+        : condition_(condition), min_consecutive_(min_consecutive), expected_samples_(expected_samples),
+          samples_seen_(0), consecutive_count_(0), longest_run_(0)
+    {
+      static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                    "OnlineConsecutiveSamplesWithConditionTrue only supports float and double types");
+    }
+
+    void push(T sample)
+    {
+      if (isDecided())
+        return;
+
+      ++samples_seen_;
+      if (condition_(sample))
+      {
+        consecutive_count_++;
+        if (consecutive_count_ > longest_run_)
+        {
+          longest_run_ = consecutive_count_;
+        }
+      }
+      else
+      {
+        consecutive_count_ = 0;
+      }
+    }
+
+    template <typename Range, typename = EnableIfRange<Range>>
+    void push(const Range &samples)
+    {
+      for (size_t i = 0; i < samples.size() && !isDecided(); ++i)
+      {
+        push(samples[i]);
+      }
+    }
+
+    bool isDecided() const
+    {
+      if (longest_run_ >= min_consecutive_)
+        return true;
+
+      // Fails early when even an unbroken tail cannot complete a run
+      return expected_samples_ > 0 && samples_seen_ <= expected_samples_ &&
+             consecutive_count_ + (expected_samples_ - samples_seen_) < min_consecutive_;
+    }
+
+    bool verdict() const { return longest_run_ >= min_consecutive_; }
+    size_t longestRun() const { return longest_run_; }
+    size_t samplesSeen() const { return samples_seen_; }
+
+  private:
+    Predicate condition_;
+    size_t min_consecutive_;
+    size_t expected_samples_;
+    size_t samples_seen_;
+    size_t consecutive_count_;
+    size_t longest_run_;
+  };
+
+  template <typename T, typename Predicate>
+  OnlineSamplesWithConditionTrue<T, Predicate> makeOnlineSamplesWithConditionTrue(
+      Predicate condition, size_t min_samples, size_t expected_samples = 0)
+  {
+    return OnlineSamplesWithConditionTrue<T, Predicate>(condition, min_samples, expected_samples);
+  }
+
+  template <typename T, typename Predicate>
+  OnlineConsecutiveSamplesWithConditionTrue<T, Predicate> makeOnlineConsecutiveSamplesWithConditionTrue(
+      Predicate condition, size_t min_consecutive, size_t expected_samples = 0)
+  {
+    return OnlineConsecutiveSamplesWithConditionTrue<T, Predicate>(condition, min_consecutive, expected_samples);
+  }
+
+  namespace detail
+  {
+    template <typename T>
+    struct AboveThreshold
+    {
+      T threshold;
+      bool operator()(T value) const { return value > threshold; }
+    };
+
+    template <typename T>
+    struct BelowThreshold
+    {
+      T threshold;
+      bool operator()(T value) const { return value < threshold; }
+    };
+  }
+
+  template <typename T>
+  class OnlineSamplesAboveThreshold
+      : public OnlineSamplesWithConditionTrue<T, detail::AboveThreshold<T>>
+  {
+  public:
+    OnlineSamplesAboveThreshold(T threshold, size_t min_samples, size_t expected_samples = 0)
+        : OnlineSamplesWithConditionTrue<T, detail::AboveThreshold<T>>(
+              detail::AboveThreshold<T>{threshold}, min_samples, expected_samples)
+    {
+    }
+  };
+
+  template <typename T>
+  class OnlineSamplesBelowThreshold
+      : public OnlineSamplesWithConditionTrue<T, detail::BelowThreshold<T>>
+  {
+  public:
+    OnlineSamplesBelowThreshold(T threshold, size_t min_samples, size_t expected_samples = 0)
+        : OnlineSamplesWithConditionTrue<T, detail::BelowThreshold<T>>(
+              detail::BelowThreshold<T>{threshold}, min_samples, expected_samples)
+    {
+    }
+  };
+
+  template <typename T>
+  class OnlineConsecutiveSamplesAboveThreshold
+      : public OnlineConsecutiveSamplesWithConditionTrue<T, detail::AboveThreshold<T>>
+  {
+  public:
+    OnlineConsecutiveSamplesAboveThreshold(T threshold, size_t min_consecutive, size_t expected_samples = 0)
+        : OnlineConsecutiveSamplesWithConditionTrue<T, detail::AboveThreshold<T>>(
+              detail::AboveThreshold<T>{threshold}, min_consecutive, expected_samples)
+    {
+    }
+  };
+
+  template <typename T>
+  class OnlineConsecutiveSamplesBelowThreshold
+      : public OnlineConsecutiveSamplesWithConditionTrue<T, detail::BelowThreshold<T>>
+  {
+  public:
+    OnlineConsecutiveSamplesBelowThreshold(T threshold, size_t min_consecutive, size_t expected_samples = 0)
+        : OnlineConsecutiveSamplesWithConditionTrue<T, detail::BelowThreshold<T>>(
+              detail::BelowThreshold<T>{threshold}, min_consecutive, expected_samples)
+    {
+    }
+  };
+
+}
@@ -0,0 +1,391 @@
+#pragma once
+
+#include <vector>
+#include <type_traits>
+#include <atomic>
+#include <numeric>
+#include <algorithm>
+#include <cmath>
+
+#include "reference_testing/ranges.h"
+#include "reference_testing/simd_kernels.h"
+#include "reference_testing/online_checkers.h"
+#include "reference_testing/thread_pool.h"
+
+namespace lumos
+{
+
+  // Parallel variants of the reductions in bounds_checker.h that split one
+  // long channel across the threads of a pool.
+  //
+  // The data is cut into chunks of kParallelChunkSize samples regardless of
+  // the number of threads, floating point partial sums are reduced per chunk
+  // and combined in chunk order, so the result is identical for any pool
+  // size. Channels shorter than one chunk give exactly the serial result;
+  // longer ones may differ from it in the last bits.
+  //
+  // Searches that can stop early (a bound violation, enough samples, a long
+  // enough run) share a flag that makes all other chunks stop as well. Inputs
+  // must be contiguous ranges.
+
+  constexpr size_t kParallelChunkSize = size_t(1) << 18;
+
+  namespace detail
+  {
+    inline size_t parallelChunkCount(size_t n)
+    {
+      return (n + kParallelChunkSize - 1) / kParallelChunkSize;
+    }
+
+    // Runs in a chunk of a consecutive-samples search
+    struct RunSummary
+    {
+      size_t length;
+      size_t prefix;
+      size_t suffix;
+      size_t longest;
+    };
+
+    template <typename T, typename Predicate>
+    RunSummary summarizeRuns(const T *values, size_t n, Predicate condition, size_t min_consecutive,
+                             const std::atomic<bool> &found)
+    {
+      RunSummary summary{n, 0, 0, 0};
+      bool in_prefix = true;
+      size_t run = 0;
+      for (size_t i = 0; i < n; ++i)
+      {
+        if (condition(values[i]))
+        {
+          run++;
+          summary.longest = std::max(summary.longest, run);
+          if (run >= min_consecutive)
+          {
+            break;
+          }
+        }
+        else
+        {
+          if (in_prefix)
+          {
+            summary.prefix = run;
+            in_prefix = false;
+          }
+          run = 0;
+        }
+
+        if ((i + 1) % kKernelBlockSize == 0 && found.load(std::memory_order_relaxed))
+        {
+          break;
+        }
+      }
+
+      if (in_prefix)
+      {
+        summary.prefix = run;
+      }
+      summary.suffix = run;
+      return summary;
+    }
+
+    template <typename T, typename Predicate>
+    bool hasAtLeastNConsecutiveSamplesParallel(ThreadPool &pool, const T *values, size_t n,
+                                               Predicate condition, size_t min_consecutive)
+    {
+      if (min_consecutive == 0)
+      {
+        return true;
+      }
+
+      const size_t chunk_count = parallelChunkCount(n);
+      std::vector<RunSummary> summaries(chunk_count);
+      std::atomic<bool> found(false);
+
+      pool.parallelFor(chunk_count, [&](size_t chunk)
+                       {
+                         if (found.load(std::memory_order_relaxed))
+                         {
+                           return;
+                         }
+                         const size_t start = chunk * kParallelChunkSize;
+                         const size_t count = std::min(kParallelChunkSize, n - start);
+                         summaries[chunk] = summarizeRuns(values + start, count, condition, min_consecutive, found);
+                         if (summaries[chunk].longest >= min_consecutive)
+                         {
+                           found.store(true, std::memory_order_relaxed);
+                         } });
+
+      if (found.load())
+      {
+        return true;
+      }
+
+      // Join runs that cross chunk boundaries, in chunk order
+      size_t running = 0;
+      for (const RunSummary &summary : summaries)
+      {
+        if (summary.prefix == summary.length)
+        {
+          running += summary.length;
+        }
+        else
+        {
+          running += summary.prefix;
+          if (running >= min_consecutive)
+          {
+            return true;
+          }
+          running = summary.suffix;
+        }
+
+        if (running >= min_consecutive)
+        {
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    template <typename T, typename BlockCounter>
+    bool hasAtLeastNSamplesParallel(ThreadPool &pool, const T *values, size_t n,
+                                    BlockCounter count_block, size_t min_samples)
+    {
+      if (min_samples == 0)
+      {
+        return true;
+      }
+
+      std::atomic<size_t> total(0);
+      pool.parallelFor(parallelChunkCount(n), [&](size_t chunk)
+                       {
+                         const size_t end = std::min(n, (chunk + 1) * kParallelChunkSize);
+                         for (size_t start = chunk * kParallelChunkSize;
+                              start < end && total.load(std::memory_order_relaxed) < min_samples;
+                              start += kKernelBlockSize)
+                         {
+                           total.fetch_add(count_block(values + start, std::min(kKernelBlockSize, end - start)),
+                                           std::memory_order_relaxed);
+                         } });
+
+      return total.load() >= min_samples;
+    }
+  }
+
+  // Index of the first test sample outside [min_bounds, max_bounds], or the
+  // number of samples if there is none. Chunks past an already found
+  // violation are skipped.
+  template <typename TestRange, typename BoundRange>
+  size_t findFirstOutsideBoundsParallel(ThreadPool &pool,
+                                        const TestRange &test_vector,
+                                        const BoundRange &min_bounds,
+                                        const BoundRange &max_bounds)
+  {
+    using T = RangeValueType<TestRange>;
+    static_assert(std::is_same_v<T, RangeValueType<BoundRange>>,
+                  "findFirstOutsideBoundsParallel requires test and bound ranges of the same value type");
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                  "findFirstOutsideBoundsParallel only supports float and double types");
+    static_assert(IsContiguousRange<TestRange>::value && IsContiguousRange<BoundRange>::value,
+                  "findFirstOutsideBoundsParallel requires contiguous ranges");
+
+    const size_t n = test_vector.size();
+    if (min_bounds.size() != n || max_bounds.size() != n)
+    {
+      throw std::invalid_argument("Test and bound vectors must have the same size");
+    }
+
+    const T *test = test_vector.data();
+    const T *min_data = min_bounds.data();
+    const T *max_data = max_bounds.data();
+    std::atomic<size_t> first(n);
+
+    pool.parallelFor(detail::parallelChunkCount(n), [&](size_t chunk)
+                     {
+                       const size_t end = std::min(n, (chunk + 1) * kParallelChunkSize);
+                       for (size_t start = chunk * kParallelChunkSize; start < end; start += kKernelBlockSize)
+                       {
+                         if (start >= first.load(std::memory_order_relaxed))
+                         {
+                           return;
+                         }
+
+                         const size_t count = std::min(kKernelBlockSize, end - start);
+                         const size_t index = findFirstOutsideBounds(test + start, min_data + start, max_data + start, count);
+                         if (index < count)
+                         {
+                           size_t found = start + index;
+                           size_t current = first.load(std::memory_order_relaxed);
+                           while (found < current && !first.compare_exchange_weak(current, found))
+                           {
+                           }
+                           return;
+                         }
+                       } });
+
+    return first.load();
+  }
+
+  template <typename TestRange, typename BoundRange>
+  bool isWithinBoundsParallel(ThreadPool &pool,
+                              const TestRange &test_vector,
+                              const BoundRange &min_bounds,
+                              const BoundRange &max_bounds)
+  {
+    if (test_vector.size() != min_bounds.size() || test_vector.size() != max_bounds.size())
+    {
+      return false;
+    }
+
+    return findFirstOutsideBoundsParallel(pool, test_vector, min_bounds, max_bounds) == test_vector.size();
+  }
+
+  template <typename TestRange, typename ReferenceRange>
+  bool isVarianceWithinThresholdParallel(ThreadPool &pool,
+                                         const TestRange &test_vector,
+                                         const ReferenceRange &reference_vector,
+                                         RangeValueType<TestRange> threshold)
+  {
+    using T = RangeValueType<TestRange>;
+    static_assert(std::is_same_v<T, RangeValueType<ReferenceRange>>,
+                  "isVarianceWithinThresholdParallel requires test and reference ranges of the same value type");
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                  "isVarianceWithinThresholdParallel only supports float and double types");
+    static_assert(IsContiguousRange<TestRange>::value && IsContiguousRange<ReferenceRange>::value,
+                  "isVarianceWithinThresholdParallel requires contiguous ranges");
+
+    if (test_vector.size() != reference_vector.size())
+    {
+      return false;
+    }
+
+    if (test_vector.empty())
+    {
+      return true;
+    }
+
+    const size_t n = test_vector.size();
+    std::vector<T> partial_sums(detail::parallelChunkCount(n));
+    pool.parallelFor(partial_sums.size(), [&](size_t chunk)
+                     {
+                       const size_t start = chunk * kParallelChunkSize;
+                       partial_sums[chunk] = sumSquaredDifference(test_vector.data() + start, reference_vector.data() + start,
+                                                                  std::min(kParallelChunkSize, n - start)); });
+
+    T sum_squared_diff = std::accumulate(partial_sums.begin(), partial_sums.end(), T(0));
+    T variance = sum_squared_diff / static_cast<T>(n);
+    return variance <= threshold;
+  }
+
+  template <typename TestRange, typename ReferenceRange>
+  bool isMeanDifferenceWithinThresholdParallel(ThreadPool &pool,
+                                               const TestRange &test_vector,
+                                               const ReferenceRange &reference_vector,
+                                               RangeValueType<TestRange> threshold)
+  {
+    using T = RangeValueType<TestRange>;
+    static_assert(std::is_same_v<T, RangeValueType<ReferenceRange>>,
+                  "isMeanDifferenceWithinThresholdParallel requires test and reference ranges of the same value type");
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                  "isMeanDifferenceWithinThresholdParallel only supports float and double types");
+    static_assert(IsContiguousRange<TestRange>::value && IsContiguousRange<ReferenceRange>::value,
+                  "isMeanDifferenceWithinThresholdParallel requires contiguous ranges");
+
+    if (test_vector.size() != reference_vector.size())
+    {
+      return false;
+    }
+
+    if (test_vector.empty())
+    {
+      return true;
+    }
+
+    const size_t n = test_vector.size();
+    const size_t chunk_count = detail::parallelChunkCount(n);
+    std::vector<T> test_sums(chunk_count), reference_sums(chunk_count);
+    pool.parallelFor(chunk_count, [&](size_t chunk)
+                     {
+                       const size_t start = chunk * kParallelChunkSize;
+                       const size_t end = std::min(n, start + kParallelChunkSize);
+                       test_sums[chunk] = std::accumulate(test_vector.data() + start, test_vector.data() + end, T(0));
+                       reference_sums[chunk] = std::accumulate(reference_vector.data() + start, reference_vector.data() + end, T(0)); });
+
+    T test_mean = std::accumulate(test_sums.begin(), test_sums.end(), T(0)) / static_cast<T>(n);
+    T ref_mean = std::accumulate(reference_sums.begin(), reference_sums.end(), T(0)) / static_cast<T>(n);
+
+    T mean_diff = std::abs(test_mean - ref_mean);
+    return mean_diff <= threshold;
+  }
+
+  template <typename Range>
+  bool hasAtLeastNSamplesAboveThresholdParallel(ThreadPool &pool,
+                                                const Range &test_vector,
+                                                RangeValueType<Range> threshold,
+                                                size_t min_samples)
+  {
+    using T = RangeValueType<Range>;
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                  "hasAtLeastNSamplesAboveThresholdParallel only supports float and double types");
+    static_assert(IsContiguousRange<Range>::value,
+                  "hasAtLeastNSamplesAboveThresholdParallel requires a contiguous range");
+
+    return detail::hasAtLeastNSamplesParallel(
+        pool, test_vector.data(), test_vector.size(),
+        [threshold](const T *values, size_t count)
+        { return countAboveThreshold(values, count, threshold); },
+        min_samples);
+  }
+
+  template <typename Range>
+  bool hasAtLeastNSamplesBelowThresholdParallel(ThreadPool &pool,
+                                                const Range &test_vector,
+                                                RangeValueType<Range> threshold,
+                                                size_t min_samples)
+  {
+    using T = RangeValueType<Range>;
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                  "hasAtLeastNSamplesBelowThresholdParallel only supports float and double types");
+    static_assert(IsContiguousRange<Range>::value,
+                  "hasAtLeastNSamplesBelowThresholdParallel requires a contiguous range");
+
+    return detail::hasAtLeastNSamplesParallel(
+        pool, test_vector.data(), test_vector.size(),
+        [threshold](const T *values, size_t count)
+        { return countBelowThreshold(values, count, threshold); },
+        min_samples);
+  }
+
+  template <typename Range>
+  bool hasAtLeastNConsecutiveSamplesAboveThresholdParallel(ThreadPool &pool,
+                                                           const Range &test_vector,
+                                                           RangeValueType<Range> threshold,
+                                                           size_t min_consecutive)
+  {
+    using T = RangeValueType<Range>;
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                  "hasAtLeastNConsecutiveSamplesAboveThresholdParallel only supports float and double types");
+    static_assert(IsContiguousRange<Range>::value,
+                  "hasAtLeastNConsecutiveSamplesAboveThresholdParallel requires a contiguous range");
+
+    return detail::hasAtLeastNConsecutiveSamplesParallel(pool, test_vector.data(), test_vector.size(),
+                                                         detail::AboveThreshold<T>{threshold}, min_consecutive);
+  }
+
+  template <typename Range>
+  bool hasAtLeastNConsecutiveSamplesBelowThresholdParallel(ThreadPool &pool,
+                                                           const Range &test_vector,
+                                                           RangeValueType<Range> threshold,
+                                                           size_t min_consecutive)
+  {
+    using T = RangeValueType<Range>;
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                  "hasAtLeastNConsecutiveSamplesBelowThresholdParallel only supports float and double types");
+    static_assert(IsContiguousRange<Range>::value,
+                  "hasAtLeastNConsecutiveSamplesBelowThresholdParallel requires a contiguous range");
+
+    return detail::hasAtLeastNConsecutiveSamplesParallel(pool, test_vector.data(), test_vector.size(),
+                                                         detail::BelowThreshold<T>{threshold}, min_consecutive);
+  }
+
+}
@@ -0,0 +1,278 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <type_traits>
+#include <stdexcept>
+#include <limits>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "reference_testing/ranges.h"
+#include "reference_testing/reference_container.h"
+
+// The decoded bound base + q * step must round identically when the bounds
+// are built and when they are checked, so it is never contracted into an FMA
+#if defined(__clang__)
+#pragma float_control(push)
+#pragma clang fp contract(off)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+namespace lumos
+{
+
+  // A min/max bounds envelope stored as 8 or 16 bit fixed point. Each block
+  // of kBlockSize samples has its own base and step, and a bound is decoded
+  // as base + q * step.
+  //
+  // Rounding is conservative: decoded min bounds are never above the
+  // original ones and decoded max bounds never below, so the envelope only
+  // widens and every test that passes the original bounds passes these.
+  // The widening is at most one step per block; a tolerance given at
+  // construction is checked against the actual widening.
+  template <typename T, typename Q>
+  class QuantizedBounds
+  {
+  public:
+    static constexpr size_t kBlockSize = 256;
+
+    template <typename BoundRange>
+    QuantizedBounds(const BoundRange &min_bounds, const BoundRange &max_bounds,
+                    T tolerance = std::numeric_limits<T>::infinity())
+        : size_(min_bounds.size()), max_widening_(T(0))
+    {
+      static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                    "QuantizedBounds only supports float and double types");
+      static_assert(std::is_same_v<Q, uint8_t> || std::is_same_v<Q, uint16_t>,
+                    "QuantizedBounds only supports 8 and 16 bit storage");
+      static_assert(std::is_same_v<T, RangeValueType<BoundRange>>,
+                    "QuantizedBounds requires bound ranges of its value type");
+
+      if (min_bounds.size() != max_bounds.size())
+      {
+        throw std::invalid_argument("Min and max bounds must have the same size");
+      }
+
+      const size_t block_count = (size_ + kBlockSize - 1) / kBlockSize;
+      min_q_.resize(size_);
+      max_q_.resize(size_);
+      base_.resize(block_count);
+      step_.resize(block_count);
+
+      for (size_t b = 0; b < block_count; ++b)
+      {
+        const size_t begin = b * kBlockSize;
+        const size_t end = std::min(size_, begin + kBlockSize);
+
+        T low = std::numeric_limits<T>::infinity();
+        T high = -std::numeric_limits<T>::infinity();
+        for (size_t i = begin; i < end; ++i)
+        {
+          if (!std::isfinite(min_bounds[i]) || !std::isfinite(max_bounds[i]))
+          {
+            throw std::invalid_argument("Quantized bounds must be finite");
+          }
+          low = std::min({low, min_bounds[i], max_bounds[i]});
+          high = std::max({high, min_bounds[i], max_bounds[i]});
+        }
+
+        // Nudge the step up until the top code reaches the block maximum
+        T step = (high - low) / static_cast<T>(kMaxCode);
+        while (decode(low, step, kMaxCode) < high)
+        {
+          step = std::nextafter(step, std::numeric_limits<T>::infinity());
+        }
+        base_[b] = low;
+        step_[b] = step;
+
+        for (size_t i = begin; i < end; ++i)
+        {
+          min_q_[i] = quantizeDown(min_bounds[i], low, step);
+          max_q_[i] = quantizeUp(max_bounds[i], low, step);
+          max_widening_ = std::max({max_widening_,
+                                    min_bounds[i] - decode(low, step, min_q_[i]),
+                                    decode(low, step, max_q_[i]) - max_bounds[i]});
+        }
+      }
+
+      if (max_widening_ > tolerance)
+      {
+        throw std::invalid_argument("Quantization widens the bounds beyond the tolerance");
+      }
+    }
+
+    // Rebuilds bounds from their stored representation
+    QuantizedBounds(std::vector<Q> min_q, std::vector<Q> max_q, std::vector<T> base, std::vector<T> step)
+        : size_(min_q.size()), min_q_(std::move(min_q)), max_q_(std::move(max_q)),
+          base_(std::move(base)), step_(std::move(step)), max_widening_(std::numeric_limits<T>::quiet_NaN())
+    {
+      if (max_q_.size() != size_ || base_.size() != (size_ + kBlockSize - 1) / kBlockSize ||
+          step_.size() != base_.size())
+      {
+        throw std::invalid_argument("Inconsistent quantized bounds data");
+      }
+    }
+
+    size_t size() const { return size_; }
+
+    T minAt(size_t index) const
+    {
+      return decode(base_[index / kBlockSize], step_[index / kBlockSize], min_q_[index]);
+    }
+
+    T maxAt(size_t index) const
+    {
+      return decode(base_[index / kBlockSize], step_[index / kBlockSize], max_q_[index]);
+    }
+
+    // Largest distance a bound was moved outwards, NaN when rebuilt from storage
+    T maxWidening() const { return max_widening_; }
+
+    // Index of the first test sample outside the decoded bounds, or the
+    // number of samples if there is none
+    size_t findFirstOutside(const T *test, size_t n) const
+    {
+      if (n != size_)
+      {
+        throw std::invalid_argument("Test vector and bounds must have the same size");
+      }
+
+      for (size_t begin = 0; begin < n; begin += kBlockSize)
+      {
+        const size_t b = begin / kBlockSize;
+        const size_t end = std::min(n, begin + kBlockSize);
+        const T base = base_[b];
+        const T step = step_[b];
+
+        // Branch-free over the block so the compare loop vectorises
+        bool outside = false;
+        for (size_t i = begin; i < end; ++i)
+        {
+          outside |= (test[i] < decode(base, step, min_q_[i])) | (test[i] > decode(base, step, max_q_[i]));
+        }
+
+        if (outside)
+        {
+          for (size_t i = begin; i < end; ++i)
+          {
+            if (test[i] < decode(base, step, min_q_[i]) || test[i] > decode(base, step, max_q_[i]))
+            {
+              return i;
+            }
+          }
+        }
+      }
+
+      return n;
+    }
+
+    const std::vector<Q> &minCodes() const { return min_q_; }
+    const std::vector<Q> &maxCodes() const { return max_q_; }
+    const std::vector<T> &blockBases() const { return base_; }
+    const std::vector<T> &blockSteps() const { return step_; }
+
+  private:
+    static constexpr unsigned kMaxCode = std::numeric_limits<Q>::max();
+
+    static T decode(T base, T step, unsigned code)
+    {
+      return base + static_cast<T>(code) * step;
+    }
+
+    static Q quantizeDown(T value, T base, T step)
+    {
+      if (step == T(0))
+      {
+        return 0;
+      }
+
+      unsigned code = static_cast<unsigned>(std::clamp(std::floor((value - base) / step), T(0), static_cast<T>(kMaxCode)));
+      while (code > 0 && decode(base, step, code) > value)
+      {
+        --code;
+      }
+      return static_cast<Q>(code);
+    }
+
+    static Q quantizeUp(T value, T base, T step)
+    {
+      if (step == T(0))
+      {
+        return 0;
+      }
+
+      unsigned code = static_cast<unsigned>(std::clamp(std::ceil((value - base) / step), T(0), static_cast<T>(kMaxCode)));
+      while (code < kMaxCode && decode(base, step, code) < value)
+      {
+        ++code;
+      }
+      return static_cast<Q>(code);
+    }
+
+    size_t size_;
+    std::vector<Q> min_q_;
+    std::vector<Q> max_q_;
+    std::vector<T> base_;
+    std::vector<T> step_;
+    T max_widening_;
+  };
+
+  template <typename TestRange, typename T, typename Q>
+  bool isWithinBounds(const TestRange &test_vector, const QuantizedBounds<T, Q> &bounds)
+  {
+    static_assert(std::is_same_v<T, RangeValueType<TestRange>>,
+                  "isWithinBounds requires a test range of the bounds' value type");
+
+    if (test_vector.size() != bounds.size())
+    {
+      return false;
+    }
+
+    if constexpr (IsContiguousRange<TestRange>::value)
+    {
+      return bounds.findFirstOutside(test_vector.data(), test_vector.size()) == test_vector.size();
+    }
+    else
+    {
+      for (size_t i = 0; i < test_vector.size(); ++i)
+      {
+        if (test_vector[i] < bounds.minAt(i) || test_vector[i] > bounds.maxAt(i))
+        {
+          return false;
+        }
+      }
+
+      return true;
+    }
+  }
+
+  // Stores quantized bounds in a container as the channels <name>.min_q,
+  // <name>.max_q, <name>.base and <name>.step
+  template <typename T, typename Q>
+  void addQuantizedBounds(ReferenceContainerWriter &writer, const std::string &name,
+                          const QuantizedBounds<T, Q> &bounds)
+  {
+    writer.addChannel(name + ".min_q", bounds.minCodes());
+    writer.addChannel(name + ".max_q", bounds.maxCodes());
+    writer.addChannel(name + ".base", bounds.blockBases());
+    writer.addChannel(name + ".step", bounds.blockSteps());
+  }
+
+  template <typename T, typename Q>
+  QuantizedBounds<T, Q> loadQuantizedBounds(const ReferenceContainer &container, const std::string &name)
+  {
+    return QuantizedBounds<T, Q>(container.load<Q>(name + ".min_q"), container.load<Q>(name + ".max_q"),
+                                 container.load<T>(name + ".base"), container.load<T>(name + ".step"));
+  }
+
+}
+
+#if defined(__clang__)
+#pragma float_control(pop)
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
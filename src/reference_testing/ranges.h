@@ -0,0 +1,225 @@
+#pragma once
+
+#include <type_traits>
+#include <utility>
+#include <iterator>
+#include <cstddef>
+#include <stdexcept>
+
+namespace lumos
+{
+
+  // The checkers accept any range type that provides value_type, size(),
+  // operator[] and begin()/end(), e.g. std::vector<T> or MappedVector<T>.
+  // Ranges on the test side of a check share one type, as do ranges on the
+  // reference side, so reference data can be mapped while test data is not.
+  template <typename Range>
+  using RangeValueType = std::remove_cv_t<typename Range::value_type>;
+
+  template <typename Range, typename = void>
+  struct IsRange : std::false_type
+  {
+  };
+
+  template <typename Range>
+  struct IsRange<Range, std::void_t<typename Range::value_type,
+                                    decltype(std::declval<const Range &>().size()),
+                                    decltype(std::declval<const Range &>()[0])>> : std::true_type
+  {
+  };
+
+  template <typename Range>
+  using EnableIfRange = std::enable_if_t<IsRange<Range>::value>;
+
+  // Ranges whose elements can be handed to pointer-based kernels
+  template <typename Range, typename = void>
+  struct IsContiguousRange : std::false_type
+  {
+  };
+
+  template <typename Range>
+  struct IsContiguousRange<Range, std::enable_if_t<std::is_convertible_v<
+                                      decltype(std::declval<const Range &>().data()),
+                                      const typename Range::value_type *>>> : std::true_type
+  {
+  };
+
+  // Non-owning view of contiguous elements, a minimal C++17 stand-in for
+  // std::span. Constructible from any range that provides data() and size().
+  template <typename T>
+  class Span
+  {
+  public:
+    using value_type = std::remove_cv_t<T>;
+    using iterator = T *;
+
+    Span() : data_(nullptr), size_(0) {}
+    Span(T *data, size_t size) : data_(data), size_(size) {}
+
+    template <typename Range,
+              typename = std::enable_if_t<std::is_convertible_v<decltype(std::declval<Range &>().data()), T *>>>
+    Span(Range &range) : data_(range.data()), size_(range.size())
+    {
+    }
+
+    T *data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    T &operator[](size_t index) const { return data_[index]; }
+
+    iterator begin() const { return data_; }
+    iterator end() const { return data_ + size_; }
+
+    Span subspan(size_t offset, size_t count) const
+    {
+      return Span(data_ + offset, count);
+    }
+
+  private:
+    T *data_;
+    size_t size_;
+  };
+
+  // Random-access iterator over elements spaced a fixed number of bytes apart
+  template <typename T>
+  class StridedIterator
+  {
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_cv_t<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T *;
+    using reference = T &;
+
+    StridedIterator() : element_(nullptr), stride_(0) {}
+    StridedIterator(T *element, std::ptrdiff_t stride) : element_(element), stride_(stride) {}
+
+    T &operator*() const { return *element_; }
+    T *operator->() const { return element_; }
+    T &operator[](difference_type n) const { return *(*this + n); }
+
+    StridedIterator &operator++() { return *this += 1; }
+    StridedIterator &operator--() { return *this -= 1; }
+    StridedIterator operator++(int)
+    {
+      StridedIterator previous = *this;
+      *this += 1;
+      return previous;
+    }
+    StridedIterator operator--(int)
+    {
+      StridedIterator previous = *this;
+      *this -= 1;
+      return previous;
+    }
+
+    StridedIterator &operator+=(difference_type n)
+    {
+      element_ = advance(element_, n * stride_);
+      return *this;
+    }
+    StridedIterator &operator-=(difference_type n) { return *this += -n; }
+
+    friend StridedIterator operator+(StridedIterator it, difference_type n) { return it += n; }
+    friend StridedIterator operator+(difference_type n, StridedIterator it) { return it += n; }
+    friend StridedIterator operator-(StridedIterator it, difference_type n) { return it -= n; }
+
+    friend difference_type operator-(const StridedIterator &a, const StridedIterator &b)
+    {
+      // Default-constructed iterators point nowhere and compare equal
+      if (a.element_ == nullptr && b.element_ == nullptr)
+      {
+        return 0;
+      }
+      return (reinterpret_cast<const char *>(a.element_) - reinterpret_cast<const char *>(b.element_)) / a.stride_;
+    }
+
+    friend bool operator==(const StridedIterator &a, const StridedIterator &b) { return a.element_ == b.element_; }
+    friend bool operator!=(const StridedIterator &a, const StridedIterator &b) { return a.element_ != b.element_; }
+    friend bool operator<(const StridedIterator &a, const StridedIterator &b) { return (b - a) > 0; }
+    friend bool operator>(const StridedIterator &a, const StridedIterator &b) { return b < a; }
+    friend bool operator<=(const StridedIterator &a, const StridedIterator &b) { return !(b < a); }
+    friend bool operator>=(const StridedIterator &a, const StridedIterator &b) { return !(a < b); }
+
+  private:
+    template <typename>
+    friend class StridedSpan;
+
+    static T *advance(T *element, std::ptrdiff_t bytes)
+    {
+      using Byte = std::conditional_t<std::is_const_v<T>, const char, char>;
+      return reinterpret_cast<T *>(reinterpret_cast<Byte *>(element) + bytes);
+    }
+
+    T *element_;
+    std::ptrdiff_t stride_;
+  };
+
+  // Non-owning view of elements spaced stride bytes apart, such as one
+  // channel of an interleaved log or one field of an array of structs.
+  // Checkers take the non-contiguous path for it and read the data in place.
+  //
+  //   struct Row { double t; double x; double y; };
+  //   StridedSpan<const double> x = fieldSpan(rows.data(), rows.size(), &Row::x);
+  //   isWithinBounds(x, x_min, x_max);
+  template <typename T>
+  class StridedSpan
+  {
+  public:
+    using value_type = std::remove_cv_t<T>;
+    using iterator = StridedIterator<T>;
+
+    StridedSpan() : data_(nullptr), size_(0), stride_(sizeof(T)) {}
+    // A zero stride would repeat one element, which iterating checkers
+    // cannot tell apart from an empty range
+    StridedSpan(T *data, size_t size, std::ptrdiff_t stride) : data_(data), size_(size), stride_(stride)
+    {
+      if (stride == 0)
+      {
+        throw std::invalid_argument("StridedSpan stride must not be zero");
+      }
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    std::ptrdiff_t stride() const { return stride_; }
+
+    T &operator[](size_t index) const
+    {
+      return *iterator::advance(data_, static_cast<std::ptrdiff_t>(index) * stride_);
+    }
+
+    iterator begin() const { return iterator(data_, stride_); }
+    iterator end() const { return begin() + static_cast<std::ptrdiff_t>(size_); }
+
+    StridedSpan subspan(size_t offset, size_t count) const
+    {
+      return StridedSpan(&(*this)[offset], count, stride_);
+    }
+
+  private:
+    T *data_;
+    size_t size_;
+    std::ptrdiff_t stride_;
+  };
+
+  // One field of each element of an array of structs
+  template <typename Row, typename T>
+  StridedSpan<const T> fieldSpan(const Row *rows, size_t count, T Row::*field)
+  {
+    if (count == 0)
+    {
+      return StridedSpan<const T>(nullptr, 0, sizeof(Row));
+    }
+    return StridedSpan<const T>(&(rows->*field), count, sizeof(Row));
+  }
+
+  // Channel `channel` of row-major data with `channels` values per row
+  template <typename T>
+  StridedSpan<const T> interleavedChannel(const T *data, size_t rows, size_t channels, size_t channel)
+  {
+    return StridedSpan<const T>(data + channel, rows, static_cast<std::ptrdiff_t>(channels * sizeof(T)));
+  }
+
+}
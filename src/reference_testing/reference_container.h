@@ -0,0 +1,621 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <fstream>
+#include <type_traits>
+#include <stdexcept>
+#include <cstring>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "reference_testing/ranges.h"
+#include "reference_testing/binary_serializer.h"
+#include "reference_testing/codecs.h"
+
+namespace lumos
+{
+
+    // Single-file container for many named channels.
+    //
+    // Layout, all integers in the byte order given by the byte order mark:
+    //
+    //   0   char[8]  magic "LUMOSRC\0"
+    //   8   uint32   byte order mark 0x01020304
+    //   12  uint32   format version
+    //   16  uint64   channel count
+    //   24  uint64   offset of the table of contents
+    //   32  uint64   size of the table of contents in bytes
+    //   40  zero padding up to 64
+    //   64  channel payloads, each starting at a multiple of 64 bytes
+    //   ... table of contents, one entry per channel:
+    //         uint32 name length, uint8 type tag, uint8 encoding,
+    //         uint16 reserved, uint64 element count, uint64 payload offset,
+    //         uint64 payload size in bytes, name bytes
+    //
+    // Raw payloads are written in the writer's native byte order, encoded
+    // payloads (see codecs.h) are byte order independent. Type tags are fixed
+    // numbers rather than compiler-specific type names.
+
+    constexpr char kContainerMagic[8] = {'L', 'U', 'M', 'O', 'S', 'R', 'C', '\0'};
+    constexpr uint32_t kContainerByteOrderMark = 0x01020304;
+    constexpr uint32_t kContainerVersion = 1;
+    constexpr size_t kContainerHeaderSize = 64;
+    // Size of a table of contents entry with an empty name
+    constexpr size_t kContainerTocEntrySize = 32;
+
+    enum class ContainerTypeTag : uint8_t
+    {
+        Float32 = 1,
+        Float64 = 2,
+        Int8 = 3,
+        Int16 = 4,
+        Int32 = 5,
+        Int64 = 6,
+        UInt8 = 7,
+        UInt16 = 8,
+        UInt32 = 9,
+        UInt64 = 10
+    };
+
+    template <typename T>
+    struct ContainerTypeTagOf;
+
+    template <> struct ContainerTypeTagOf<float> { static constexpr ContainerTypeTag value = ContainerTypeTag::Float32; };
+    template <> struct ContainerTypeTagOf<double> { static constexpr ContainerTypeTag value = ContainerTypeTag::Float64; };
+    template <> struct ContainerTypeTagOf<int8_t> { static constexpr ContainerTypeTag value = ContainerTypeTag::Int8; };
+    template <> struct ContainerTypeTagOf<int16_t> { static constexpr ContainerTypeTag value = ContainerTypeTag::Int16; };
+    template <> struct ContainerTypeTagOf<int32_t> { static constexpr ContainerTypeTag value = ContainerTypeTag::Int32; };
+    template <> struct ContainerTypeTagOf<int64_t> { static constexpr ContainerTypeTag value = ContainerTypeTag::Int64; };
+    template <> struct ContainerTypeTagOf<uint8_t> { static constexpr ContainerTypeTag value = ContainerTypeTag::UInt8; };
+    template <> struct ContainerTypeTagOf<uint16_t> { static constexpr ContainerTypeTag value = ContainerTypeTag::UInt16; };
+    template <> struct ContainerTypeTagOf<uint32_t> { static constexpr ContainerTypeTag value = ContainerTypeTag::UInt32; };
+    template <> struct ContainerTypeTagOf<uint64_t> { static constexpr ContainerTypeTag value = ContainerTypeTag::UInt64; };
+
+    inline size_t containerTypeSize(ContainerTypeTag tag)
+    {
+        switch (tag)
+        {
+        case ContainerTypeTag::Int8:
+        case ContainerTypeTag::UInt8:
+            return 1;
+        case ContainerTypeTag::Int16:
+        case ContainerTypeTag::UInt16:
+            return 2;
+        case ContainerTypeTag::Float32:
+        case ContainerTypeTag::Int32:
+        case ContainerTypeTag::UInt32:
+            return 4;
+        case ContainerTypeTag::Float64:
+        case ContainerTypeTag::Int64:
+        case ContainerTypeTag::UInt64:
+            return 8;
+        }
+        return 0;
+    }
+
+    struct ContainerChannel
+    {
+        std::string name;
+        ContainerTypeTag type;
+        ContainerEncoding encoding;
+        size_t element_count;
+        size_t payload_offset;
+        size_t payload_size;
+    };
+
+    namespace detail
+    {
+        inline void byteSwap(void *data, size_t element_size, size_t count)
+        {
+            unsigned char *bytes = static_cast<unsigned char *>(data);
+            for (size_t i = 0; i < count; ++i, bytes += element_size)
+            {
+                std::reverse(bytes, bytes + element_size);
+            }
+        }
+
+        // Bounds-checked sequential reads from a byte buffer, swapping
+        // integers when the file was written with the other byte order
+        class ByteCursor
+        {
+        public:
+            ByteCursor(const unsigned char *data, size_t size, bool swap, const std::string &filename)
+                : data_(data), size_(size), position_(0), swap_(swap), filename_(filename)
+            {
+            }
+
+            template <typename U>
+            U read()
+            {
+                U value;
+                readBytes(&value, sizeof(U));
+                if (swap_)
+                {
+                    byteSwap(&value, sizeof(U), 1);
+                }
+                return value;
+            }
+
+            void readBytes(void *destination, size_t count)
+            {
+                if (count > size_ - position_)
+                {
+                    throw std::runtime_error("Truncated container: " + filename_);
+                }
+                std::memcpy(destination, data_ + position_, count);
+                position_ += count;
+            }
+
+        private:
+            const unsigned char *data_;
+            size_t size_;
+            size_t position_;
+            bool swap_;
+            const std::string &filename_;
+        };
+
+        template <typename U>
+        void writeInteger(std::ostream &file, U value)
+        {
+            file.write(reinterpret_cast<const char *>(&value), sizeof(U));
+        }
+
+        inline void padToAlignment(std::ostream &file, size_t alignment)
+        {
+            const size_t position = static_cast<size_t>(file.tellp());
+            const size_t padding = (alignment - position % alignment) % alignment;
+            for (size_t i = 0; i < padding; ++i)
+            {
+                file.put('\0');
+            }
+        }
+    }
+
+    // Writes a container channel by channel. Payloads are streamed to the
+    // file as they are added; the table of contents and the header are
+    // written on close().
+    class ReferenceContainerWriter
+    {
+    public:
+        explicit ReferenceContainerWriter(const std::string &filename)
+            : filename_(filename), file_(filename, std::ios::binary)
+        {
+            if (!file_.is_open())
+            {
+                throw std::runtime_error("Failed to open file for writing: " + filename);
+            }
+
+            // Placeholder header, rewritten on close()
+            const char zeros[kContainerHeaderSize] = {};
+            file_.write(zeros, kContainerHeaderSize);
+        }
+
+        ~ReferenceContainerWriter()
+        {
+            try
+            {
+                close();
+            }
+            catch (...)
+            {
+            }
+        }
+
+        ReferenceContainerWriter(const ReferenceContainerWriter &) = delete;
+        ReferenceContainerWriter &operator=(const ReferenceContainerWriter &) = delete;
+
+        template <typename T>
+        void addChannel(const std::string &name, const T *data, size_t count,
+                        ContainerEncoding encoding = ContainerEncoding::Raw)
+        {
+            static_assert(std::is_trivially_copyable_v<T>,
+                          "Type T must be trivially copyable for binary serialization");
+
+            if (encoding == ContainerEncoding::Raw)
+            {
+                addRawChannel(name, ContainerTypeTagOf<T>::value, encoding, count, data, count * sizeof(T));
+            }
+            else
+            {
+                const std::vector<unsigned char> encoded = encodeBlocks(data, count, encoding);
+                addRawChannel(name, ContainerTypeTagOf<T>::value, encoding, count, encoded.data(), encoded.size());
+            }
+        }
+
+        template <typename T>
+        void addChannel(const std::string &name, const std::vector<T> &data,
+                        ContainerEncoding encoding = ContainerEncoding::Raw)
+        {
+            addChannel(name, data.data(), data.size(), encoding);
+        }
+
+        // Adds an already encoded payload of element_count elements
+        void addRawChannel(const std::string &name, ContainerTypeTag type, ContainerEncoding encoding,
+                           size_t element_count, const void *payload, size_t payload_size)
+        {
+            if (!file_.is_open())
+            {
+                throw std::runtime_error("Writer already closed: " + filename_);
+            }
+
+            for (const ContainerChannel &channel : channels_)
+            {
+                if (channel.name == name)
+                {
+                    throw std::invalid_argument("Duplicate channel name: " + name);
+                }
+            }
+
+            detail::padToAlignment(file_, kBinaryPayloadAlignment);
+            const size_t offset = static_cast<size_t>(file_.tellp());
+            if (payload_size > 0)
+            {
+                file_.write(static_cast<const char *>(payload), payload_size);
+            }
+
+            if (!file_.good())
+            {
+                throw std::runtime_error("Error writing to file: " + filename_);
+            }
+
+            channels_.push_back(ContainerChannel{name, type, encoding, element_count, offset, payload_size});
+        }
+
+        size_t size() const
+        {
+            return channels_.size();
+        }
+
+        void close()
+        {
+            if (!file_.is_open())
+            {
+                return;
+            }
+
+            detail::padToAlignment(file_, 8);
+            const uint64_t toc_offset = static_cast<uint64_t>(file_.tellp());
+            for (const ContainerChannel &channel : channels_)
+            {
+                detail::writeInteger<uint32_t>(file_, static_cast<uint32_t>(channel.name.size()));
+                detail::writeInteger<uint8_t>(file_, static_cast<uint8_t>(channel.type));
+                detail::writeInteger<uint8_t>(file_, static_cast<uint8_t>(channel.encoding));
+                detail::writeInteger<uint16_t>(file_, 0);
+                detail::writeInteger<uint64_t>(file_, channel.element_count);
+                detail::writeInteger<uint64_t>(file_, channel.payload_offset);
+                detail::writeInteger<uint64_t>(file_, channel.payload_size);
+                file_.write(channel.name.data(), channel.name.size());
+            }
+            const uint64_t toc_size = static_cast<uint64_t>(file_.tellp()) - toc_offset;
+
+            file_.seekp(0);
+            file_.write(kContainerMagic, sizeof(kContainerMagic));
+            detail::writeInteger<uint32_t>(file_, kContainerByteOrderMark);
+            detail::writeInteger<uint32_t>(file_, kContainerVersion);
+            detail::writeInteger<uint64_t>(file_, channels_.size());
+            detail::writeInteger<uint64_t>(file_, toc_offset);
+            detail::writeInteger<uint64_t>(file_, toc_size);
+
+            const bool good = file_.good();
+            file_.close();
+
+            if (!good)
+            {
+                throw std::runtime_error("Error writing to file: " + filename_);
+            }
+        }
+
+    private:
+        std::string filename_;
+        std::ofstream file_;
+        std::vector<ContainerChannel> channels_;
+    };
+
+    // Read-only access to a container. The file is opened and memory mapped
+    // once; the table of contents is parsed up front and channels are
+    // located by name without touching the other payloads.
+    //
+    //   ReferenceContainer reference("reference.lrc");
+    //   Span<const double> x = reference.view<double>("x");
+    //   std::vector<double> y = reference.load<double>("y");
+    class ReferenceContainer
+    {
+    public:
+        explicit ReferenceContainer(const std::string &filename) : filename_(filename)
+        {
+            const int fd = ::open(filename.c_str(), O_RDONLY);
+            if (fd < 0)
+            {
+                throw std::runtime_error("Failed to open file for reading: " + filename);
+            }
+
+            struct stat file_stat;
+            if (::fstat(fd, &file_stat) != 0 || static_cast<size_t>(file_stat.st_size) < kContainerHeaderSize)
+            {
+                ::close(fd);
+                throw std::runtime_error("Error reading from file: " + filename);
+            }
+
+            mapping_size_ = static_cast<size_t>(file_stat.st_size);
+            mapping_ = ::mmap(nullptr, mapping_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+
+            if (mapping_ == MAP_FAILED)
+            {
+                mapping_ = nullptr;
+                throw std::runtime_error("Failed to map file: " + filename);
+            }
+
+            try
+            {
+                parse();
+            }
+            catch (...)
+            {
+                unmap();
+                throw;
+            }
+        }
+
+        ~ReferenceContainer()
+        {
+            unmap();
+        }
+
+        ReferenceContainer(const ReferenceContainer &) = delete;
+        ReferenceContainer &operator=(const ReferenceContainer &) = delete;
+
+        ReferenceContainer(ReferenceContainer &&other) noexcept
+            : filename_(std::move(other.filename_)), mapping_(other.mapping_), mapping_size_(other.mapping_size_),
+              swapped_(other.swapped_), channels_(std::move(other.channels_)), index_(std::move(other.index_))
+        {
+            other.mapping_ = nullptr;
+            other.mapping_size_ = 0;
+        }
+
+        size_t size() const
+        {
+            return channels_.size();
+        }
+
+        const std::vector<ContainerChannel> &channels() const
+        {
+            return channels_;
+        }
+
+        bool hasChannel(const std::string &name) const
+        {
+            return index_.count(name) > 0;
+        }
+
+        const ContainerChannel &channel(const std::string &name) const
+        {
+            auto it = index_.find(name);
+            if (it == index_.end())
+            {
+                throw std::runtime_error("Channel not found in " + filename_ + ": " + name);
+            }
+            return channels_[it->second];
+        }
+
+        // True when the file was written on a host with the other byte order
+        bool isByteSwapped() const
+        {
+            return swapped_;
+        }
+
+        // Zero-copy view into the mapping, valid while the container lives
+        template <typename T>
+        Span<const T> view(const std::string &name) const
+        {
+            const ContainerChannel &entry = checkedChannel<T>(name);
+            if (swapped_)
+            {
+                throw std::runtime_error("Channel " + name + " has foreign byte order, use load()");
+            }
+            if (entry.encoding != ContainerEncoding::Raw)
+            {
+                throw std::runtime_error("Channel " + name + " is encoded, use load()");
+            }
+            return Span<const T>(reinterpret_cast<const T *>(payload(entry)), entry.element_count);
+        }
+
+        template <typename T>
+        std::vector<T> load(const std::string &name) const
+        {
+            const ContainerChannel &entry = checkedChannel<T>(name);
+            if (entry.encoding != ContainerEncoding::Raw)
+            {
+                return decoder<T>(name).decodeAll();
+            }
+
+            std::vector<T> result(entry.element_count);
+            if (!result.empty())
+            {
+                std::memcpy(result.data(), payload(entry), entry.payload_size);
+            }
+            if (swapped_)
+            {
+                detail::byteSwap(result.data(), sizeof(T), result.size());
+            }
+            return result;
+        }
+
+        // Elements [begin, end) of a channel. Raw channels copy only the
+        // window, encoded channels decode only the blocks overlapping it.
+        template <typename T>
+        std::vector<T> loadSlice(const std::string &name, size_t begin, size_t end) const
+        {
+            const ContainerChannel &entry = checkedChannel<T>(name);
+            if (begin > end || end > entry.element_count)
+            {
+                throw std::invalid_argument("Slice range exceeds the channel size");
+            }
+
+            std::vector<T> result(end - begin);
+            if (result.empty())
+            {
+                return result;
+            }
+
+            if (entry.encoding == ContainerEncoding::Raw)
+            {
+                std::memcpy(result.data(), payload(entry) + begin * sizeof(T), result.size() * sizeof(T));
+                if (swapped_)
+                {
+                    detail::byteSwap(result.data(), sizeof(T), result.size());
+                }
+                return result;
+            }
+
+            const BlockDecoder<T> blocks = decoder<T>(name);
+            std::vector<T> block(kCodecBlockSize);
+            for (size_t b = begin / kCodecBlockSize; b * kCodecBlockSize < end; ++b)
+            {
+                const size_t block_begin = b * kCodecBlockSize;
+                const size_t count = blocks.decodeBlock(b, block.data());
+                const size_t first = std::max(begin, block_begin);
+                const size_t last = std::min(end, block_begin + count);
+                std::copy(block.begin() + (first - block_begin), block.begin() + (last - block_begin),
+                          result.begin() + (first - begin));
+            }
+            return result;
+        }
+
+        // Block-wise decoding of a channel, raw channels included. The decoder
+        // reads from the mapping and is valid while the container lives.
+        template <typename T>
+        BlockDecoder<T> decoder(const std::string &name) const
+        {
+            const ContainerChannel &entry = checkedChannel<T>(name);
+            if (swapped_ && entry.encoding == ContainerEncoding::Raw)
+            {
+                throw std::runtime_error("Channel " + name + " has foreign byte order, use load()");
+            }
+            return BlockDecoder<T>(payload(entry), entry.payload_size, entry.element_count, entry.encoding);
+        }
+
+        // Raw payload bytes of a channel as stored in the file
+        const unsigned char *payload(const ContainerChannel &entry) const
+        {
+            return static_cast<const unsigned char *>(mapping_) + entry.payload_offset;
+        }
+
+    private:
+        template <typename T>
+        const ContainerChannel &checkedChannel(const std::string &name) const
+        {
+            static_assert(std::is_trivially_copyable_v<T>,
+                          "Type T must be trivially copyable for binary deserialization");
+
+            const ContainerChannel &entry = channel(name);
+            if (entry.type != ContainerTypeTagOf<T>::value)
+            {
+                throw std::runtime_error("Type mismatch for channel " + name + " in " + filename_);
+            }
+            return entry;
+        }
+
+        void parse()
+        {
+            const unsigned char *bytes = static_cast<const unsigned char *>(mapping_);
+            if (std::memcmp(bytes, kContainerMagic, sizeof(kContainerMagic)) != 0)
+            {
+                throw std::runtime_error("Not a reference container: " + filename_);
+            }
+
+            uint32_t byte_order_mark;
+            std::memcpy(&byte_order_mark, bytes + 8, sizeof(byte_order_mark));
+            if (byte_order_mark == kContainerByteOrderMark)
+            {
+                swapped_ = false;
+            }
+            else
+            {
+                detail::byteSwap(&byte_order_mark, sizeof(byte_order_mark), 1);
+                if (byte_order_mark != kContainerByteOrderMark)
+                {
+                    throw std::runtime_error("Invalid byte order mark: " + filename_);
+                }
+                swapped_ = true;
+            }
+
+            detail::ByteCursor header(bytes + 12, kContainerHeaderSize - 12, swapped_, filename_);
+            const uint32_t version = header.read<uint32_t>();
+            if (version != kContainerVersion)
+            {
+                throw std::runtime_error("Unsupported container version " + std::to_string(version) +
+                                         ": " + filename_);
+            }
+            const uint64_t channel_count = header.read<uint64_t>();
+            const uint64_t toc_offset = header.read<uint64_t>();
+            const uint64_t toc_size = header.read<uint64_t>();
+
+            if (toc_offset > mapping_size_ || toc_size > mapping_size_ - toc_offset)
+            {
+                throw std::runtime_error("Truncated container: " + filename_);
+            }
+            if (channel_count > toc_size / kContainerTocEntrySize)
+            {
+                throw std::runtime_error("Channel count exceeds table of contents: " + filename_);
+            }
+
+            detail::ByteCursor toc(bytes + toc_offset, toc_size, swapped_, filename_);
+            channels_.reserve(channel_count);
+            for (uint64_t c = 0; c < channel_count; ++c)
+            {
+                ContainerChannel entry;
+                const uint32_t name_length = toc.read<uint32_t>();
+                entry.type = static_cast<ContainerTypeTag>(toc.read<uint8_t>());
+                entry.encoding = static_cast<ContainerEncoding>(toc.read<uint8_t>());
+                toc.read<uint16_t>();
+                entry.element_count = toc.read<uint64_t>();
+                entry.payload_offset = toc.read<uint64_t>();
+                entry.payload_size = toc.read<uint64_t>();
+                entry.name.resize(name_length);
+                toc.readBytes(&entry.name[0], name_length);
+
+                const size_t element_size = containerTypeSize(entry.type);
+                if (element_size == 0 || entry.encoding > ContainerEncoding::XorFloat)
+                {
+                    throw std::runtime_error("Unknown type or encoding for channel " + entry.name + " in " + filename_);
+                }
+                if (entry.payload_offset > mapping_size_ || entry.payload_size > mapping_size_ - entry.payload_offset ||
+                    (entry.encoding == ContainerEncoding::Raw &&
+                     (entry.payload_size % element_size != 0 || entry.element_count != entry.payload_size / element_size)))
+                {
+                    throw std::runtime_error("Corrupt channel " + entry.name + " in " + filename_);
+                }
+
+                index_[entry.name] = channels_.size();
+                channels_.push_back(std::move(entry));
+            }
+        }
+
+        void unmap()
+        {
+            if (mapping_ != nullptr)
+            {
+                ::munmap(mapping_, mapping_size_);
+                mapping_ = nullptr;
+                mapping_size_ = 0;
+            }
+        }
+
+        std::string filename_;
+        void *mapping_ = nullptr;
+        size_t mapping_size_ = 0;
+        bool swapped_ = false;
+        std::vector<ContainerChannel> channels_;
+        std::unordered_map<std::string, size_t> index_;
+    };
+
+}
@@ -0,0 +1,262 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <typeinfo>
+#include <type_traits>
+#include <stdexcept>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "reference_testing/binary_serializer.h"
+#include "reference_testing/time_window.h"
+
+namespace lumos
+{
+
+    // Header fields of a file written by saveBinaryVector
+    struct BinaryFileInfo
+    {
+        std::string type_name;
+        size_t element_size;
+        size_t element_count;
+        size_t payload_offset;
+        size_t file_size;
+    };
+
+    namespace detail
+    {
+        // Reads exactly count bytes at offset, retrying short reads
+        inline void preadExact(int fd, void *destination, size_t count, size_t offset, const std::string &filename)
+        {
+            char *out = static_cast<char *>(destination);
+            while (count > 0)
+            {
+                const ssize_t result = ::pread(fd, out, count, static_cast<off_t>(offset));
+                if (result <= 0)
+                {
+                    throw std::runtime_error("Error reading from file: " + filename);
+                }
+                out += result;
+                offset += static_cast<size_t>(result);
+                count -= static_cast<size_t>(result);
+            }
+        }
+
+        // Closes the descriptor when leaving scope
+        class FileDescriptor
+        {
+        public:
+            explicit FileDescriptor(const std::string &filename) : fd_(::open(filename.c_str(), O_RDONLY))
+            {
+                if (fd_ < 0)
+                {
+                    throw std::runtime_error("Failed to open file for reading: " + filename);
+                }
+            }
+
+            ~FileDescriptor()
+            {
+                ::close(fd_);
+            }
+
+            FileDescriptor(const FileDescriptor &) = delete;
+            FileDescriptor &operator=(const FileDescriptor &) = delete;
+
+            int get() const { return fd_; }
+
+        private:
+            int fd_;
+        };
+
+        // Parses the header with a handful of small reads, without touching
+        // the payload. The type name is reported without its padding.
+        inline BinaryFileInfo readBinaryFileInfo(int fd, const std::string &filename)
+        {
+            struct stat file_stat;
+            if (::fstat(fd, &file_stat) != 0)
+            {
+                throw std::runtime_error("Error reading from file: " + filename);
+            }
+
+            BinaryFileInfo info;
+            info.file_size = static_cast<size_t>(file_stat.st_size);
+
+            size_t type_name_length = 0;
+            preadExact(fd, &type_name_length, sizeof(type_name_length), 0, filename);
+            if (type_name_length > info.file_size)
+            {
+                throw std::runtime_error("Error reading from file: " + filename);
+            }
+
+            std::vector<char> stored_type_name(type_name_length + 1, '\0');
+            preadExact(fd, stored_type_name.data(), type_name_length, sizeof(size_t), filename);
+            info.type_name = stored_type_name.data();
+
+            size_t sizes[2];
+            preadExact(fd, sizes, sizeof(sizes), sizeof(size_t) + type_name_length, filename);
+            info.element_size = sizes[0];
+            info.element_count = sizes[1];
+            info.payload_offset = 3 * sizeof(size_t) + type_name_length;
+            return info;
+        }
+    }
+
+    // Reads only the header of a binary vector file, for discovering and
+    // sanity-checking reference files without knowing their element type
+    inline BinaryFileInfo readBinaryFileInfo(const std::string &filename)
+    {
+        detail::FileDescriptor file(filename);
+        return detail::readBinaryFileInfo(file.get(), filename);
+    }
+
+    // Lazily loaded reference vector. Construction reads and validates the
+    // header only, so size() is available after a few bytes of I/O and a size
+    // mismatch can be rejected before the payload is read. The payload is
+    // read on first element access; slice() reads just the requested range.
+    //
+    //   ReferenceHandle<double> reference("x_ref.bin");
+    //   if (reference.size() != test.size()) { ... }        // header only
+    //   isWithinBounds(test, reference_min, reference_max);  // loads payloads
+    //
+    // Materialisation is not synchronised: call load() before sharing a
+    // handle between threads.
+    template <typename T>
+    class ReferenceHandle
+    {
+    public:
+        using value_type = T;
+        using const_iterator = const T *;
+
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "Type T must be trivially copyable for binary deserialization");
+
+        explicit ReferenceHandle(const std::string &filename) : filename_(filename), loaded_(false)
+        {
+            detail::FileDescriptor file(filename);
+            const BinaryFileInfo info = detail::readBinaryFileInfo(file.get(), filename);
+
+            if (info.type_name != typeid(T).name())
+            {
+                throw std::runtime_error("Type mismatch: file contains " + info.type_name +
+                                         ", requested " + std::string(typeid(T).name()));
+            }
+
+            if (info.element_size != sizeof(T))
+            {
+                throw std::runtime_error("Element size mismatch");
+            }
+
+            // A truncated payload is caught here rather than on first access
+            if (info.payload_offset > info.file_size ||
+                info.element_count > (info.file_size - info.payload_offset) / sizeof(T))
+            {
+                throw std::runtime_error("Error reading from file: " + filename);
+            }
+
+            size_ = info.element_count;
+            payload_offset_ = info.payload_offset;
+        }
+
+        const std::string &filename() const { return filename_; }
+        size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+        bool isLoaded() const { return loaded_; }
+        size_t payloadOffset() const { return payload_offset_; }
+
+        // Reads the payload if it has not been read yet
+        const std::vector<T> &load() const
+        {
+            if (!loaded_)
+            {
+                values_ = slice(0, size_);
+                loaded_ = true;
+            }
+            return values_;
+        }
+
+        // Drops the payload; the next access reads it again
+        void release()
+        {
+            std::vector<T>().swap(values_);
+            loaded_ = false;
+        }
+
+        // Reads elements [begin, end) without loading the rest
+        std::vector<T> slice(size_t begin, size_t end) const
+        {
+            if (begin > end || end > size_)
+            {
+                throw std::invalid_argument("Slice range exceeds the reference size");
+            }
+
+            std::vector<T> result(end - begin);
+            readSlice(begin, end, result.data());
+            return result;
+        }
+
+        // Reads elements [begin, end) into caller-provided storage
+        void readSlice(size_t begin, size_t end, T *destination) const
+        {
+            if (begin > end || end > size_)
+            {
+                throw std::invalid_argument("Slice range exceeds the reference size");
+            }
+
+            if (begin == end)
+            {
+                return;
+            }
+
+            if (loaded_)
+            {
+                std::copy(values_.begin() + begin, values_.begin() + end, destination);
+                return;
+            }
+
+            detail::FileDescriptor file(filename_);
+            detail::preadExact(file.get(), destination, (end - begin) * sizeof(T),
+                               payload_offset_ + begin * sizeof(T), filename_);
+        }
+
+        const T *data() const { return load().data(); }
+        const T &operator[](size_t index) const { return load()[index]; }
+        const T &front() const { return load().front(); }
+        const T &back() const { return load().back(); }
+
+        const_iterator begin() const { return data(); }
+        const_iterator end() const { return data() + size_; }
+
+    private:
+        std::string filename_;
+        size_t size_;
+        size_t payload_offset_;
+        mutable std::vector<T> values_;
+        mutable bool loaded_;
+    };
+
+    // Time window lookup on a timebase that has not been loaded. Each probe of
+    // the binary search is a single pread, so only O(log n) elements are read.
+    template <typename T>
+    IndexRange findTimeWindow(const ReferenceHandle<T> &time, T start, T stop)
+    {
+        if (time.isLoaded())
+        {
+            return findTimeWindow(time.load(), start, stop);
+        }
+
+        detail::FileDescriptor file(time.filename());
+        return detail::findTimeWindow(time.size(), start, stop, [&](size_t i)
+                                      {
+                                          T value;
+                                          detail::preadExact(file.get(), &value, sizeof(T),
+                                                             time.payloadOffset() + i * sizeof(T), time.filename());
+                                          return value; });
+    }
+
+}
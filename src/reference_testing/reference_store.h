@@ -0,0 +1,229 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <filesystem>
+#include <type_traits>
+#include <stdexcept>
+#include <algorithm>
+#include <cstdint>
+#include <atomic>
+
+#include <unistd.h>
+
+#include "reference_testing/binary_serializer.h"
+#include "reference_testing/reference_container.h"
+#include "reference_testing/xxhash.h"
+
+namespace lumos
+{
+
+    // Content-addressed store for reference channels.
+    //
+    //   <root>/objects/<hash>.bin   payloads in saveBinaryVector format
+    //   <root>/refs/<name>          "<object hash> <parameter hash>"
+    //
+    // An object is named after the XXH64 of its payload, seeded with the
+    // element type, so identical channels of different tests share one file
+    // and rewriting unchanged data costs no disk writes: put() only writes
+    // an object that does not exist yet and a ref whose content changed.
+    // Both are written to a temporary file and renamed into place.
+    //
+    // get() hashes the payload chunk by chunk while reading it and fails on
+    // a mismatch, so integrity is verified without a second pass.
+    class ReferenceStore
+    {
+    public:
+        struct Entry
+        {
+            uint64_t object_hash;
+            uint64_t parameter_hash;
+        };
+
+        explicit ReferenceStore(const std::string &root) : root_(root)
+        {
+            std::filesystem::create_directories(root_ / "objects");
+            std::filesystem::create_directories(root_ / "refs");
+        }
+
+        template <typename T>
+        static uint64_t contentHash(const T *data, size_t count)
+        {
+            return XXHash64::hash(data, count * sizeof(T), typeSeed<T>());
+        }
+
+        // Stores data under name and returns its content hash. parameter_hash
+        // identifies the inputs the data was generated from, see getOrGenerate()
+        template <typename T>
+        uint64_t put(const std::string &name, const std::vector<T> &data, uint64_t parameter_hash = 0)
+        {
+            static_assert(std::is_trivially_copyable_v<T>,
+                          "Type T must be trivially copyable for binary serialization");
+
+            const uint64_t hash = contentHash(data.data(), data.size());
+            const std::filesystem::path object = objectPath(hash);
+            if (!std::filesystem::exists(object))
+            {
+                const std::filesystem::path temporary = temporaryPath(object);
+                saveBinaryVector(data, temporary.string());
+                std::filesystem::rename(temporary, object);
+            }
+
+            const Entry entry{hash, parameter_hash};
+            Entry existing;
+            if (!readEntry(name, existing) || existing.object_hash != entry.object_hash ||
+                existing.parameter_hash != entry.parameter_hash)
+            {
+                writeEntry(name, entry);
+            }
+            return hash;
+        }
+
+        template <typename T>
+        std::vector<T> get(const std::string &name) const
+        {
+            return getObject<T>(entry(name).object_hash);
+        }
+
+        bool contains(const std::string &name) const
+        {
+            Entry unused;
+            return readEntry(name, unused);
+        }
+
+        Entry entry(const std::string &name) const
+        {
+            Entry result;
+            if (!readEntry(name, result))
+            {
+                throw std::runtime_error("Reference not found in store: " + name);
+            }
+            return result;
+        }
+
+        // Loads the reference if it was stored from the same parameters,
+        // otherwise calls generate() and stores its result
+        template <typename T, typename Generate>
+        std::vector<T> getOrGenerate(const std::string &name, uint64_t parameter_hash, Generate generate)
+        {
+            Entry existing;
+            if (readEntry(name, existing) && existing.parameter_hash == parameter_hash &&
+                std::filesystem::exists(objectPath(existing.object_hash)))
+            {
+                return getObject<T>(existing.object_hash);
+            }
+
+            std::vector<T> data = generate();
+            put(name, data, parameter_hash);
+            return data;
+        }
+
+        template <typename T>
+        std::vector<T> getObject(uint64_t hash) const
+        {
+            const std::string filename = objectPath(hash).string();
+            std::ifstream file(filename, std::ios::binary);
+            if (!file.is_open())
+            {
+                throw std::runtime_error("Failed to open file for reading: " + filename);
+            }
+
+            const BinaryHeader header = readBinaryHeader<T>(file, filename);
+            std::vector<T> result(header.element_count);
+
+            XXHash64 hasher(typeSeed<T>());
+            char *destination = reinterpret_cast<char *>(result.data());
+            size_t remaining = result.size() * sizeof(T);
+            while (remaining > 0)
+            {
+                const size_t count = std::min(remaining, kVerifyChunkBytes);
+                file.read(destination, count);
+                if (!file.good())
+                {
+                    throw std::runtime_error("Error reading from file: " + filename);
+                }
+                hasher.update(destination, count);
+                destination += count;
+                remaining -= count;
+            }
+
+            if (hasher.digest() != hash)
+            {
+                throw std::runtime_error("Integrity check failed for " + filename);
+            }
+            return result;
+        }
+
+    private:
+        // Small enough to stay in cache between reading and hashing
+        static constexpr size_t kVerifyChunkBytes = size_t(1) << 18;
+
+        template <typename T>
+        static uint64_t typeSeed()
+        {
+            return (static_cast<uint64_t>(ContainerTypeTagOf<T>::value) << 8) | sizeof(T);
+        }
+
+        std::filesystem::path objectPath(uint64_t hash) const
+        {
+            return root_ / "objects" / (hashToHex(hash) + ".bin");
+        }
+
+        std::filesystem::path refPath(const std::string &name) const
+        {
+            if (name.empty() || name.find('/') != std::string::npos || name == "." || name == "..")
+            {
+                throw std::invalid_argument("Invalid reference name: " + name);
+            }
+            return root_ / "refs" / name;
+        }
+
+        // Unique per process and call so concurrent writers never share one
+        static std::filesystem::path temporaryPath(const std::filesystem::path &target)
+        {
+            static std::atomic<uint64_t> counter(0);
+            return target.string() + ".tmp." + std::to_string(::getpid()) + "." + std::to_string(counter++);
+        }
+
+        bool readEntry(const std::string &name, Entry &entry) const
+        {
+            std::ifstream file(refPath(name));
+            if (!file.is_open())
+            {
+                return false;
+            }
+
+            std::string object_hex, parameter_hex;
+            if (!(file >> object_hex >> parameter_hex))
+            {
+                return false;
+            }
+            entry.object_hash = std::stoull(object_hex, nullptr, 16);
+            entry.parameter_hash = std::stoull(parameter_hex, nullptr, 16);
+            return true;
+        }
+
+        void writeEntry(const std::string &name, const Entry &entry) const
+        {
+            const std::filesystem::path target = refPath(name);
+            const std::filesystem::path temporary = temporaryPath(target);
+            {
+                std::ofstream file(temporary);
+                if (!file.is_open())
+                {
+                    throw std::runtime_error("Failed to open file for writing: " + temporary.string());
+                }
+                file << hashToHex(entry.object_hash) << " " << hashToHex(entry.parameter_hash) << "\n";
+                if (!file.good())
+                {
+                    throw std::runtime_error("Error writing to file: " + temporary.string());
+                }
+            }
+            std::filesystem::rename(temporary, target);
+        }
+
+        std::filesystem::path root_;
+    };
+
+}
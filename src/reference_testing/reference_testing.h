@@ -1,4 +1,22 @@
 #pragma once
 
 #include "reference_testing/bounds_checker.h"
+#include "reference_testing/resample.h"
+#include "reference_testing/online_checkers.h"
+#include "reference_testing/duration_checkers.h"
+#include "reference_testing/check_expressions.h"
+#include "reference_testing/check_set.h"
+#include "reference_testing/compiled_reference.h"
+#include "reference_testing/batch_evaluator.h"
+#include "reference_testing/parallel_checkers.h"
+#include "reference_testing/violation_report.h"
+#include "reference_testing/time_window.h"
 #include "reference_testing/binary_serializer.h"
+#include "reference_testing/mapped_vector.h"
+#include "reference_testing/reference_handle.h"
+#include "reference_testing/signal_set.h"
+#include "reference_testing/arena.h"
+#include "reference_testing/reference_container.h"
+#include "reference_testing/quantized_bounds.h"
+#include "reference_testing/async_loader.h"
+#include "reference_testing/reference_store.h"
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <type_traits>
+#include <stdexcept>
+#include <algorithm>
+
+#include "reference_testing/ranges.h"
+#include "reference_testing/interpolation.h"
+#include "reference_testing/simd_kernels.h"
+
+namespace lumos
+{
+
+  enum class InterpolationMode
+  {
+    ZeroOrderHold,
+    Linear
+  };
+
+  namespace detail
+  {
+    // Number of queries gathered before the lerp step is run over them
+    constexpr size_t kResampleBlockSize = 64;
+
+    template <typename T>
+    void resampleLinear(const T *query_times, size_t query_count,
+                        Span<const T> time_vec, Span<const T> value_vec, T *output)
+    {
+      Interpolator<T> interpolator(time_vec, value_vec);
+
+      T y0[kResampleBlockSize];
+      T dy[kResampleBlockSize];
+      T dx[kResampleBlockSize];
+      T dt[kResampleBlockSize];
+
+      for (size_t block_start = 0; block_start < query_count; block_start += kResampleBlockSize)
+      {
+        const size_t block_size = std::min(kResampleBlockSize, query_count - block_start);
+
+        // Locate segments and gather the operands. Clamped queries and
+        // zero-length segments are encoded so the lerp yields y0 unchanged.
+        for (size_t k = 0; k < block_size; ++k)
+        {
+          const T t = query_times[block_start + k];
+          dy[k] = T(0);
+          dx[k] = T(0);
+          dt[k] = T(1);
+
+          if (t <= time_vec[0])
+          {
+            y0[k] = value_vec[0];
+          }
+          else if (t >= time_vec[time_vec.size() - 1])
+          {
+            y0[k] = value_vec[value_vec.size() - 1];
+          }
+          else
+          {
+            const size_t i = interpolator.findSegment(t);
+            y0[k] = value_vec[i];
+            if (time_vec[i + 1] != time_vec[i])
+            {
+              dy[k] = value_vec[i + 1] - value_vec[i];
+              dx[k] = t - time_vec[i];
+              dt[k] = time_vec[i + 1] - time_vec[i];
+            }
+          }
+        }
+
+        lerpBlock(y0, dy, dx, dt, output + block_start, block_size);
+      }
+    }
+
+    template <typename T>
+    void resampleZeroOrderHold(const T *query_times, size_t query_count,
+                               Span<const T> time_vec, Span<const T> value_vec, T *output)
+    {
+      // Cursor on the last sample whose time is not after the query
+      size_t sample = 0;
+      for (size_t k = 0; k < query_count; ++k)
+      {
+        const T t = query_times[k];
+        if (t < time_vec[0])
+        {
+          output[k] = value_vec[0];
+          continue;
+        }
+
+        if (time_vec[sample] > t)
+        {
+          sample = static_cast<size_t>(
+              std::upper_bound(time_vec.begin(), time_vec.end(), t) - time_vec.begin() - 1);
+        }
+        else
+        {
+          while (sample + 1 < time_vec.size() && time_vec[sample + 1] <= t)
+          {
+            ++sample;
+          }
+        }
+
+        output[k] = value_vec[sample];
+      }
+    }
+  }
+
+  // Resamples (time_vec, value_vec) at every query time and writes the result
+  // to output, which must hold query_count elements. Nothing is allocated.
+  // Sorted query times are processed in linear time, unsorted ones fall back
+  // to a binary search per out-of-order query. time_vec must be sorted.
+  // Queries outside the time range are clamped to the first/last value.
+  // time_vec and value_vec are any contiguous ranges, e.g. std::vector,
+  // pmr vectors, MappedVector or Span.
+  template <typename T, typename TimeRange, typename ValueRange>
+  void resample(const T *query_times, size_t query_count,
+                const TimeRange &time_vec,
+                const ValueRange &value_vec,
+                T *output,
+                InterpolationMode mode = InterpolationMode::Linear)
+  {
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                  "resample only supports float and double types");
+    static_assert(std::is_same_v<T, RangeValueType<TimeRange>> && std::is_same_v<T, RangeValueType<ValueRange>>,
+                  "resample requires time and value ranges of the query value type");
+    static_assert(IsContiguousRange<TimeRange>::value && IsContiguousRange<ValueRange>::value,
+                  "resample requires contiguous time and value ranges");
+    if (time_vec.size() != value_vec.size() || time_vec.empty())
+    {
+      throw std::invalid_argument("Time and value vectors must have same non-zero size");
+    }
+
+    const Span<const T> time_span(time_vec.data(), time_vec.size());
+    const Span<const T> value_span(value_vec.data(), value_vec.size());
+    if (mode == InterpolationMode::Linear)
+    {
+      detail::resampleLinear(query_times, query_count, time_span, value_span, output);
+    }
+    else
+    {
+      detail::resampleZeroOrderHold(query_times, query_count, time_span, value_span, output);
+    }
+  }
+
+  // Range form; output may be a vector or a Span and must already have the
+  // size of query_times
+  template <typename QueryRange, typename TimeRange, typename ValueRange, typename OutputRange,
+            typename = EnableIfRange<QueryRange>>
+  void resample(const QueryRange &query_times,
+                const TimeRange &time_vec,
+                const ValueRange &value_vec,
+                OutputRange &&output,
+                InterpolationMode mode = InterpolationMode::Linear)
+  {
+    using T = RangeValueType<QueryRange>;
+    static_assert(IsContiguousRange<QueryRange>::value,
+                  "resample requires contiguous query times");
+    const Span<T> output_span(output);
+    if (output_span.size() != query_times.size())
+    {
+      throw std::invalid_argument("Output vector must have the same size as the query times");
+    }
+
+    resample(query_times.data(), query_times.size(), time_vec, value_vec, output_span.data(), mode);
+  }
+
+}
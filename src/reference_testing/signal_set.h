@@ -0,0 +1,181 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <stdexcept>
+#include <algorithm>
+
+#include "reference_testing/ranges.h"
+#include "reference_testing/reference_handle.h"
+
+namespace lumos
+{
+
+  // A timebase and any number of named channels sampled on it, stored
+  // structure-of-arrays in one allocation. Every row starts on a kAlignment
+  // boundary, so channels are SIMD-aligned and a dataset costs one
+  // allocation instead of one per vector.
+  //
+  //   SignalSet<double> signals = SignalSet<double>::load("time.bin", {{"x", "x.bin"}, {"y", "y.bin"}});
+  //   isWithinBounds(signals.time(), signals["x"], ref_time, x_min, ref_time, x_max);
+  //
+  // time() and channels are Spans, so every checker accepts them directly.
+  template <typename T>
+  class SignalSet
+  {
+  public:
+    static constexpr size_t kAlignment = 64;
+
+    // Zero-initialised signals with sample_count samples per channel
+    SignalSet(size_t sample_count, const std::vector<std::string> &channel_names)
+        : size_(sample_count), stride_(paddedSize(sample_count)), names_(channel_names)
+    {
+      static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                    "SignalSet only supports float and double types");
+
+      for (size_t c = 0; c < names_.size(); ++c)
+      {
+        if (!index_.emplace(names_[c], c).second)
+        {
+          throw std::invalid_argument("Duplicate channel name: " + names_[c]);
+        }
+      }
+
+      const size_t element_count = stride_ * (names_.size() + 1);
+      arena_.reset(static_cast<T *>(::operator new(element_count * sizeof(T), std::align_val_t(kAlignment))));
+      std::fill(arena_.get(), arena_.get() + element_count, T(0));
+    }
+
+    // Copies a timebase and channels of the same size into one arena
+    template <typename TimeRange, typename ChannelRange>
+    SignalSet(const TimeRange &time, const std::vector<std::pair<std::string, ChannelRange>> &channels)
+        : SignalSet(time.size(), channelNames(channels))
+    {
+      std::copy(time.begin(), time.end(), row(0));
+      for (size_t c = 0; c < channels.size(); ++c)
+      {
+        if (channels[c].second.size() != size_)
+        {
+          throw std::invalid_argument("Channel " + channels[c].first + " does not match the timebase size");
+        }
+        std::copy(channels[c].second.begin(), channels[c].second.end(), row(c + 1));
+      }
+    }
+
+    // Reads a timebase and channels saved with saveBinaryVector straight into
+    // the arena. All headers are validated before the arena is allocated.
+    static SignalSet load(const std::string &time_file,
+                          const std::vector<std::pair<std::string, std::string>> &channel_files)
+    {
+      const ReferenceHandle<T> time(time_file);
+      std::vector<ReferenceHandle<T>> channels;
+      std::vector<std::string> names;
+      for (const auto &[name, filename] : channel_files)
+      {
+        channels.emplace_back(filename);
+        names.push_back(name);
+        if (channels.back().size() != time.size())
+        {
+          throw std::runtime_error("Channel " + name + " in " + filename + " does not match the timebase size");
+        }
+      }
+
+      SignalSet signals(time.size(), names);
+      time.readSlice(0, time.size(), signals.row(0));
+      for (size_t c = 0; c < channels.size(); ++c)
+      {
+        channels[c].readSlice(0, channels[c].size(), signals.row(c + 1));
+      }
+      return signals;
+    }
+
+    size_t size() const { return size_; }
+    size_t channelCount() const { return names_.size(); }
+    const std::vector<std::string> &channelNames() const { return names_; }
+
+    bool hasChannel(const std::string &name) const
+    {
+      return index_.find(name) != index_.end();
+    }
+
+    size_t channelIndex(const std::string &name) const
+    {
+      auto it = index_.find(name);
+      if (it == index_.end())
+      {
+        throw std::invalid_argument("Unknown channel: " + name);
+      }
+      return it->second;
+    }
+
+    Span<T> time() { return Span<T>(row(0), size_); }
+    Span<const T> time() const { return Span<const T>(row(0), size_); }
+
+    Span<T> channel(size_t index)
+    {
+      return Span<T>(row(checkedIndex(index) + 1), size_);
+    }
+
+    Span<const T> channel(size_t index) const
+    {
+      return Span<const T>(row(checkedIndex(index) + 1), size_);
+    }
+
+    Span<T> channel(const std::string &name) { return channel(channelIndex(name)); }
+    Span<const T> channel(const std::string &name) const { return channel(channelIndex(name)); }
+
+    Span<T> operator[](const std::string &name) { return channel(name); }
+    Span<const T> operator[](const std::string &name) const { return channel(name); }
+
+  private:
+    struct AlignedDelete
+    {
+      void operator()(T *data) const
+      {
+        ::operator delete(data, std::align_val_t(kAlignment));
+      }
+    };
+
+    static size_t paddedSize(size_t sample_count)
+    {
+      constexpr size_t per_line = kAlignment / sizeof(T);
+      return std::max<size_t>(1, (sample_count + per_line - 1) / per_line) * per_line;
+    }
+
+    template <typename ChannelRange>
+    static std::vector<std::string> channelNames(const std::vector<std::pair<std::string, ChannelRange>> &channels)
+    {
+      std::vector<std::string> names;
+      for (const auto &channel : channels)
+      {
+        names.push_back(channel.first);
+      }
+      return names;
+    }
+
+    size_t checkedIndex(size_t index) const
+    {
+      if (index >= names_.size())
+      {
+        throw std::invalid_argument("Channel index out of range");
+      }
+      return index;
+    }
+
+    // Row 0 is the timebase, row c + 1 channel c
+    T *row(size_t index) { return arena_.get() + index * stride_; }
+    const T *row(size_t index) const { return arena_.get() + index * stride_; }
+
+    size_t size_;
+    size_t stride_;
+    std::vector<std::string> names_;
+    std::unordered_map<std::string, size_t> index_;
+    std::unique_ptr<T, AlignedDelete> arena_;
+  };
+
+}
@@ -0,0 +1,648 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define LUMOS_SIMD_X86 1
+#include <immintrin.h>
+#define LUMOS_TARGET_SSE2 __attribute__((target("sse2")))
+#define LUMOS_TARGET_AVX2 __attribute__((target("avx2")))
+#define LUMOS_TARGET_AVX512 __attribute__((target("avx512f")))
+#else
+#define LUMOS_SIMD_X86 0
+#endif
+
+// Kernels for the hot loops of the checkers, with SSE2, AVX2 and AVX-512
+// implementations selected at runtime and a portable scalar fallback.
+//
+// Sums use a fixed reduction order so every implementation returns the same
+// bits: element i is accumulated into lane i % kReductionLanes<T> (8 lanes for
+// double, 16 for float), and the lanes are then folded pairwise, adding lane
+// j + w to lane j for w = lanes / 2, lanes / 4, ..., 1. Multiplies and adds
+// are never contracted into FMAs.
+
+#if defined(__clang__)
+#pragma float_control(push)
+#pragma clang fp contract(off)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+namespace lumos
+{
+
+  enum class SimdLevel
+  {
+    Scalar,
+    Sse2,
+    Avx2,
+    Avx512
+  };
+
+  template <typename T>
+  constexpr size_t kReductionLanes = 64 / sizeof(T);
+
+  // Granularity at which callers re-check early-exit conditions
+  constexpr size_t kKernelBlockSize = 4096;
+
+  inline SimdLevel detectSimdLevel()
+  {
+#if LUMOS_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+      return SimdLevel::Avx512;
+    if (__builtin_cpu_supports("avx2"))
+      return SimdLevel::Avx2;
+    if (__builtin_cpu_supports("sse2"))
+      return SimdLevel::Sse2;
+#endif
+    return SimdLevel::Scalar;
+  }
+
+  namespace detail
+  {
+    inline SimdLevel &activeSimdLevelStorage()
+    {
+      static SimdLevel level = detectSimdLevel();
+      return level;
+    }
+
+    template <typename T>
+    T foldReductionLanes(T *acc)
+    {
+      for (size_t width = kReductionLanes<T> / 2; width >= 1; width /= 2)
+      {
+        for (size_t j = 0; j < width; ++j)
+        {
+          acc[j] += acc[j + width];
+        }
+      }
+      return acc[0];
+    }
+
+    // Adds the elements past the last full block of lanes and folds the lanes.
+    // A and B are pointers or any other indexable ranges.
+    template <typename T, typename A, typename B>
+    T finishSumSquaredDifference(const A &a, const B &b, size_t start, size_t n, T *acc)
+    {
+      for (size_t i = start; i < n; ++i)
+      {
+        const T diff = a[i] - b[i];
+        acc[i - start] += diff * diff;
+      }
+      return foldReductionLanes(acc);
+    }
+
+    template <typename T>
+    size_t findFirstOutsideBoundsScalar(const T *test, const T *min_bounds, const T *max_bounds,
+                                        size_t start, size_t n)
+    {
+      for (size_t i = start; i < n; ++i)
+      {
+        if (test[i] < min_bounds[i] || test[i] > max_bounds[i])
+        {
+          return i;
+        }
+      }
+      return n;
+    }
+
+    // Portable form of the fixed-order reduction, over pointers or any other
+    // indexable ranges, so non-contiguous data gets the same bits as the
+    // vector kernels
+    template <typename T, typename A, typename B>
+    T sumSquaredDifferenceIndexed(const A &a, const B &b, size_t n)
+    {
+      constexpr size_t lanes = kReductionLanes<T>;
+      T acc[lanes] = {};
+      const size_t blocks_end = n - n % lanes;
+      for (size_t i = 0; i < blocks_end; i += lanes)
+      {
+        for (size_t j = 0; j < lanes; ++j)
+        {
+          const T diff = a[i + j] - b[i + j];
+          acc[j] += diff * diff;
+        }
+      }
+      return finishSumSquaredDifference(a, b, blocks_end, n, acc);
+    }
+
+    template <typename T>
+    T sumSquaredDifferenceScalar(const T *a, const T *b, size_t n)
+    {
+      return sumSquaredDifferenceIndexed<T>(a, b, n);
+    }
+
+    template <bool Above, typename T>
+    size_t countThresholdScalar(const T *values, size_t start, size_t n, T threshold)
+    {
+      size_t count = 0;
+      for (size_t i = start; i < n; ++i)
+      {
+        count += (Above ? values[i] > threshold : values[i] < threshold) ? 1 : 0;
+      }
+      return count;
+    }
+
+    // out[k] = y0[k] + dy[k] * dx[k] / dt[k], in the same order as
+    // linearInterpolate
+    template <typename T>
+    void lerpBlockScalar(const T *y0, const T *dy, const T *dx, const T *dt, T *out, size_t start, size_t n)
+    {
+      for (size_t k = start; k < n; ++k)
+      {
+        out[k] = y0[k] + dy[k] * dx[k] / dt[k];
+      }
+    }
+
+#if LUMOS_SIMD_X86
+    // SSE2
+
+    LUMOS_TARGET_SSE2 inline size_t findFirstOutsideBoundsSse2(const double *test, const double *min_bounds,
+                                                               const double *max_bounds, size_t n)
+    {
+      size_t i = 0;
+      for (; i + 2 <= n; i += 2)
+      {
+        const __m128d x = _mm_loadu_pd(test + i);
+        const int mask = _mm_movemask_pd(_mm_or_pd(_mm_cmplt_pd(x, _mm_loadu_pd(min_bounds + i)),
+                                                   _mm_cmpgt_pd(x, _mm_loadu_pd(max_bounds + i))));
+        if (mask != 0)
+          return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+      }
+      return findFirstOutsideBoundsScalar(test, min_bounds, max_bounds, i, n);
+    }
+
+    LUMOS_TARGET_SSE2 inline size_t findFirstOutsideBoundsSse2(const float *test, const float *min_bounds,
+                                                               const float *max_bounds, size_t n)
+    {
+      size_t i = 0;
+      for (; i + 4 <= n; i += 4)
+      {
+        const __m128 x = _mm_loadu_ps(test + i);
+        const int mask = _mm_movemask_ps(_mm_or_ps(_mm_cmplt_ps(x, _mm_loadu_ps(min_bounds + i)),
+                                                   _mm_cmpgt_ps(x, _mm_loadu_ps(max_bounds + i))));
+        if (mask != 0)
+          return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+      }
+      return findFirstOutsideBoundsScalar(test, min_bounds, max_bounds, i, n);
+    }
+
+    LUMOS_TARGET_SSE2 inline double sumSquaredDifferenceSse2(const double *a, const double *b, size_t n)
+    {
+      __m128d acc[4] = {_mm_setzero_pd(), _mm_setzero_pd(), _mm_setzero_pd(), _mm_setzero_pd()};
+      const size_t blocks_end = n - n % 8;
+      for (size_t i = 0; i < blocks_end; i += 8)
+      {
+        for (size_t r = 0; r < 4; ++r)
+        {
+          const __m128d diff = _mm_sub_pd(_mm_loadu_pd(a + i + 2 * r), _mm_loadu_pd(b + i + 2 * r));
+          acc[r] = _mm_add_pd(acc[r], _mm_mul_pd(diff, diff));
+        }
+      }
+      double lanes[8];
+      for (size_t r = 0; r < 4; ++r)
+        _mm_storeu_pd(lanes + 2 * r, acc[r]);
+      return finishSumSquaredDifference(a, b, blocks_end, n, lanes);
+    }
+
+    LUMOS_TARGET_SSE2 inline float sumSquaredDifferenceSse2(const float *a, const float *b, size_t n)
+    {
+      __m128 acc[4] = {_mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps()};
+      const size_t blocks_end = n - n % 16;
+      for (size_t i = 0; i < blocks_end; i += 16)
+      {
+        for (size_t r = 0; r < 4; ++r)
+        {
+          const __m128 diff = _mm_sub_ps(_mm_loadu_ps(a + i + 4 * r), _mm_loadu_ps(b + i + 4 * r));
+          acc[r] = _mm_add_ps(acc[r], _mm_mul_ps(diff, diff));
+        }
+      }
+      float lanes[16];
+      for (size_t r = 0; r < 4; ++r)
+        _mm_storeu_ps(lanes + 4 * r, acc[r]);
+      return finishSumSquaredDifference(a, b, blocks_end, n, lanes);
+    }
+
+    template <bool Above>
+    LUMOS_TARGET_SSE2 size_t countThresholdSse2(const double *values, size_t n, double threshold)
+    {
+      const __m128d t = _mm_set1_pd(threshold);
+      size_t count = 0;
+      size_t i = 0;
+      for (; i + 2 <= n; i += 2)
+      {
+        const __m128d x = _mm_loadu_pd(values + i);
+        const int mask = _mm_movemask_pd(Above ? _mm_cmpgt_pd(x, t) : _mm_cmplt_pd(x, t));
+        count += static_cast<size_t>(__builtin_popcount(static_cast<unsigned>(mask)));
+      }
+      return count + countThresholdScalar<Above>(values, i, n, threshold);
+    }
+
+    template <bool Above>
+    LUMOS_TARGET_SSE2 size_t countThresholdSse2(const float *values, size_t n, float threshold)
+    {
+      const __m128 t = _mm_set1_ps(threshold);
+      size_t count = 0;
+      size_t i = 0;
+      for (; i + 4 <= n; i += 4)
+      {
+        const __m128 x = _mm_loadu_ps(values + i);
+        const int mask = _mm_movemask_ps(Above ? _mm_cmpgt_ps(x, t) : _mm_cmplt_ps(x, t));
+        count += static_cast<size_t>(__builtin_popcount(static_cast<unsigned>(mask)));
+      }
+      return count + countThresholdScalar<Above>(values, i, n, threshold);
+    }
+
+    LUMOS_TARGET_SSE2 inline void lerpBlockSse2(const double *y0, const double *dy, const double *dx,
+                                                 const double *dt, double *out, size_t n)
+    {
+      size_t k = 0;
+      for (; k + 2 <= n; k += 2)
+      {
+        const __m128d scaled = _mm_div_pd(_mm_mul_pd(_mm_loadu_pd(dy + k), _mm_loadu_pd(dx + k)),
+                                          _mm_loadu_pd(dt + k));
+        _mm_storeu_pd(out + k, _mm_add_pd(_mm_loadu_pd(y0 + k), scaled));
+      }
+      lerpBlockScalar(y0, dy, dx, dt, out, k, n);
+    }
+
+    LUMOS_TARGET_SSE2 inline void lerpBlockSse2(const float *y0, const float *dy, const float *dx,
+                                                 const float *dt, float *out, size_t n)
+    {
+      size_t k = 0;
+      for (; k + 4 <= n; k += 4)
+      {
+        const __m128 scaled = _mm_div_ps(_mm_mul_ps(_mm_loadu_ps(dy + k), _mm_loadu_ps(dx + k)),
+                                         _mm_loadu_ps(dt + k));
+        _mm_storeu_ps(out + k, _mm_add_ps(_mm_loadu_ps(y0 + k), scaled));
+      }
+      lerpBlockScalar(y0, dy, dx, dt, out, k, n);
+    }
+
+    // AVX2
+
+    LUMOS_TARGET_AVX2 inline size_t findFirstOutsideBoundsAvx2(const double *test, const double *min_bounds,
+                                                               const double *max_bounds, size_t n)
+    {
+      size_t i = 0;
+      for (; i + 4 <= n; i += 4)
+      {
+        const __m256d x = _mm256_loadu_pd(test + i);
+        const int mask = _mm256_movemask_pd(
+            _mm256_or_pd(_mm256_cmp_pd(x, _mm256_loadu_pd(min_bounds + i), _CMP_LT_OQ),
+                         _mm256_cmp_pd(x, _mm256_loadu_pd(max_bounds + i), _CMP_GT_OQ)));
+        if (mask != 0)
+          return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+      }
+      return findFirstOutsideBoundsScalar(test, min_bounds, max_bounds, i, n);
+    }
+
+    LUMOS_TARGET_AVX2 inline size_t findFirstOutsideBoundsAvx2(const float *test, const float *min_bounds,
+                                                               const float *max_bounds, size_t n)
+    {
+      size_t i = 0;
+      for (; i + 8 <= n; i += 8)
+      {
+        const __m256 x = _mm256_loadu_ps(test + i);
+        const int mask = _mm256_movemask_ps(
+            _mm256_or_ps(_mm256_cmp_ps(x, _mm256_loadu_ps(min_bounds + i), _CMP_LT_OQ),
+                         _mm256_cmp_ps(x, _mm256_loadu_ps(max_bounds + i), _CMP_GT_OQ)));
+        if (mask != 0)
+          return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+      }
+      return findFirstOutsideBoundsScalar(test, min_bounds, max_bounds, i, n);
+    }
+
+    LUMOS_TARGET_AVX2 inline double sumSquaredDifferenceAvx2(const double *a, const double *b, size_t n)
+    {
+      __m256d acc_low = _mm256_setzero_pd();
+      __m256d acc_high = _mm256_setzero_pd();
+      const size_t blocks_end = n - n % 8;
+      for (size_t i = 0; i < blocks_end; i += 8)
+      {
+        const __m256d diff_low = _mm256_sub_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i));
+        const __m256d diff_high = _mm256_sub_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4));
+        acc_low = _mm256_add_pd(acc_low, _mm256_mul_pd(diff_low, diff_low));
+        acc_high = _mm256_add_pd(acc_high, _mm256_mul_pd(diff_high, diff_high));
+      }
+      double lanes[8];
+      _mm256_storeu_pd(lanes, acc_low);
+      _mm256_storeu_pd(lanes + 4, acc_high);
+      return finishSumSquaredDifference(a, b, blocks_end, n, lanes);
+    }
+
+    LUMOS_TARGET_AVX2 inline float sumSquaredDifferenceAvx2(const float *a, const float *b, size_t n)
+    {
+      __m256 acc_low = _mm256_setzero_ps();
+      __m256 acc_high = _mm256_setzero_ps();
+      const size_t blocks_end = n - n % 16;
+      for (size_t i = 0; i < blocks_end; i += 16)
+      {
+        const __m256 diff_low = _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+        const __m256 diff_high = _mm256_sub_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8));
+        acc_low = _mm256_add_ps(acc_low, _mm256_mul_ps(diff_low, diff_low));
+        acc_high = _mm256_add_ps(acc_high, _mm256_mul_ps(diff_high, diff_high));
+      }
+      float lanes[16];
+      _mm256_storeu_ps(lanes, acc_low);
+      _mm256_storeu_ps(lanes + 8, acc_high);
+      return finishSumSquaredDifference(a, b, blocks_end, n, lanes);
+    }
+
+    template <bool Above>
+    LUMOS_TARGET_AVX2 size_t countThresholdAvx2(const double *values, size_t n, double threshold)
+    {
+      const __m256d t = _mm256_set1_pd(threshold);
+      size_t count = 0;
+      size_t i = 0;
+      for (; i + 4 <= n; i += 4)
+      {
+        const __m256d x = _mm256_loadu_pd(values + i);
+        const int mask = _mm256_movemask_pd(Above ? _mm256_cmp_pd(x, t, _CMP_GT_OQ) : _mm256_cmp_pd(x, t, _CMP_LT_OQ));
+        count += static_cast<size_t>(__builtin_popcount(static_cast<unsigned>(mask)));
+      }
+      return count + countThresholdScalar<Above>(values, i, n, threshold);
+    }
+
+    template <bool Above>
+    LUMOS_TARGET_AVX2 size_t countThresholdAvx2(const float *values, size_t n, float threshold)
+    {
+      const __m256 t = _mm256_set1_ps(threshold);
+      size_t count = 0;
+      size_t i = 0;
+      for (; i + 8 <= n; i += 8)
+      {
+        const __m256 x = _mm256_loadu_ps(values + i);
+        const int mask = _mm256_movemask_ps(Above ? _mm256_cmp_ps(x, t, _CMP_GT_OQ) : _mm256_cmp_ps(x, t, _CMP_LT_OQ));
+        count += static_cast<size_t>(__builtin_popcount(static_cast<unsigned>(mask)));
+      }
+      return count + countThresholdScalar<Above>(values, i, n, threshold);
+    }
+
+    LUMOS_TARGET_AVX2 inline void lerpBlockAvx2(const double *y0, const double *dy, const double *dx,
+                                                 const double *dt, double *out, size_t n)
+    {
+      size_t k = 0;
+      for (; k + 4 <= n; k += 4)
+      {
+        const __m256d scaled = _mm256_div_pd(_mm256_mul_pd(_mm256_loadu_pd(dy + k), _mm256_loadu_pd(dx + k)),
+                                             _mm256_loadu_pd(dt + k));
+        _mm256_storeu_pd(out + k, _mm256_add_pd(_mm256_loadu_pd(y0 + k), scaled));
+      }
+      lerpBlockScalar(y0, dy, dx, dt, out, k, n);
+    }
+
+    LUMOS_TARGET_AVX2 inline void lerpBlockAvx2(const float *y0, const float *dy, const float *dx,
+                                                 const float *dt, float *out, size_t n)
+    {
+      size_t k = 0;
+      for (; k + 8 <= n; k += 8)
+      {
+        const __m256 scaled = _mm256_div_ps(_mm256_mul_ps(_mm256_loadu_ps(dy + k), _mm256_loadu_ps(dx + k)),
+                                            _mm256_loadu_ps(dt + k));
+        _mm256_storeu_ps(out + k, _mm256_add_ps(_mm256_loadu_ps(y0 + k), scaled));
+      }
+      lerpBlockScalar(y0, dy, dx, dt, out, k, n);
+    }
+
+    // AVX-512
+
+    LUMOS_TARGET_AVX512 inline size_t findFirstOutsideBoundsAvx512(const double *test, const double *min_bounds,
+                                                                   const double *max_bounds, size_t n)
+    {
+      size_t i = 0;
+      for (; i + 8 <= n; i += 8)
+      {
+        const __m512d x = _mm512_loadu_pd(test + i);
+        const unsigned mask = static_cast<unsigned>(_mm512_cmp_pd_mask(x, _mm512_loadu_pd(min_bounds + i), _CMP_LT_OQ) |
+                                                    _mm512_cmp_pd_mask(x, _mm512_loadu_pd(max_bounds + i), _CMP_GT_OQ));
+        if (mask != 0)
+          return i + static_cast<size_t>(__builtin_ctz(mask));
+      }
+      return findFirstOutsideBoundsScalar(test, min_bounds, max_bounds, i, n);
+    }
+
+    LUMOS_TARGET_AVX512 inline size_t findFirstOutsideBoundsAvx512(const float *test, const float *min_bounds,
+                                                                   const float *max_bounds, size_t n)
+    {
+      size_t i = 0;
+      for (; i + 16 <= n; i += 16)
+      {
+        const __m512 x = _mm512_loadu_ps(test + i);
+        const unsigned mask = static_cast<unsigned>(_mm512_cmp_ps_mask(x, _mm512_loadu_ps(min_bounds + i), _CMP_LT_OQ) |
+                                                    _mm512_cmp_ps_mask(x, _mm512_loadu_ps(max_bounds + i), _CMP_GT_OQ));
+        if (mask != 0)
+          return i + static_cast<size_t>(__builtin_ctz(mask));
+      }
+      return findFirstOutsideBoundsScalar(test, min_bounds, max_bounds, i, n);
+    }
+
+    LUMOS_TARGET_AVX512 inline double sumSquaredDifferenceAvx512(const double *a, const double *b, size_t n)
+    {
+      __m512d acc = _mm512_setzero_pd();
+      const size_t blocks_end = n - n % 8;
+      for (size_t i = 0; i < blocks_end; i += 8)
+      {
+        const __m512d diff = _mm512_sub_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i));
+        acc = _mm512_add_pd(acc, _mm512_mul_pd(diff, diff));
+      }
+      double lanes[8];
+      _mm512_storeu_pd(lanes, acc);
+      return finishSumSquaredDifference(a, b, blocks_end, n, lanes);
+    }
+
+    LUMOS_TARGET_AVX512 inline float sumSquaredDifferenceAvx512(const float *a, const float *b, size_t n)
+    {
+      __m512 acc = _mm512_setzero_ps();
+      const size_t blocks_end = n - n % 16;
+      for (size_t i = 0; i < blocks_end; i += 16)
+      {
+        const __m512 diff = _mm512_sub_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i));
+        acc = _mm512_add_ps(acc, _mm512_mul_ps(diff, diff));
+      }
+      float lanes[16];
+      _mm512_storeu_ps(lanes, acc);
+      return finishSumSquaredDifference(a, b, blocks_end, n, lanes);
+    }
+
+    template <bool Above>
+    LUMOS_TARGET_AVX512 size_t countThresholdAvx512(const double *values, size_t n, double threshold)
+    {
+      const __m512d t = _mm512_set1_pd(threshold);
+      size_t count = 0;
+      size_t i = 0;
+      for (; i + 8 <= n; i += 8)
+      {
+        const __m512d x = _mm512_loadu_pd(values + i);
+        const __mmask8 mask = Above ? _mm512_cmp_pd_mask(x, t, _CMP_GT_OQ) : _mm512_cmp_pd_mask(x, t, _CMP_LT_OQ);
+        count += static_cast<size_t>(__builtin_popcount(static_cast<unsigned>(mask)));
+      }
+      return count + countThresholdScalar<Above>(values, i, n, threshold);
+    }
+
+    template <bool Above>
+    LUMOS_TARGET_AVX512 size_t countThresholdAvx512(const float *values, size_t n, float threshold)
+    {
+      const __m512 t = _mm512_set1_ps(threshold);
+      size_t count = 0;
+      size_t i = 0;
+      for (; i + 16 <= n; i += 16)
+      {
+        const __m512 x = _mm512_loadu_ps(values + i);
+        const __mmask16 mask = Above ? _mm512_cmp_ps_mask(x, t, _CMP_GT_OQ) : _mm512_cmp_ps_mask(x, t, _CMP_LT_OQ);
+        count += static_cast<size_t>(__builtin_popcount(static_cast<unsigned>(mask)));
+      }
+      return count + countThresholdScalar<Above>(values, i, n, threshold);
+    }
+
+    LUMOS_TARGET_AVX512 inline void lerpBlockAvx512(const double *y0, const double *dy, const double *dx,
+                                                     const double *dt, double *out, size_t n)
+    {
+      size_t k = 0;
+      for (; k + 8 <= n; k += 8)
+      {
+        const __m512d scaled = _mm512_div_pd(_mm512_mul_pd(_mm512_loadu_pd(dy + k), _mm512_loadu_pd(dx + k)),
+                                             _mm512_loadu_pd(dt + k));
+        _mm512_storeu_pd(out + k, _mm512_add_pd(_mm512_loadu_pd(y0 + k), scaled));
+      }
+      lerpBlockScalar(y0, dy, dx, dt, out, k, n);
+    }
+
+    LUMOS_TARGET_AVX512 inline void lerpBlockAvx512(const float *y0, const float *dy, const float *dx,
+                                                     const float *dt, float *out, size_t n)
+    {
+      size_t k = 0;
+      for (; k + 16 <= n; k += 16)
+      {
+        const __m512 scaled = _mm512_div_ps(_mm512_mul_ps(_mm512_loadu_ps(dy + k), _mm512_loadu_ps(dx + k)),
+                                            _mm512_loadu_ps(dt + k));
+        _mm512_storeu_ps(out + k, _mm512_add_ps(_mm512_loadu_ps(y0 + k), scaled));
+      }
+      lerpBlockScalar(y0, dy, dx, dt, out, k, n);
+    }
+#endif
+
+    template <bool Above, typename T>
+    size_t countThreshold(const T *values, size_t n, T threshold)
+    {
+      switch (activeSimdLevelStorage())
+      {
+#if LUMOS_SIMD_X86
+      case SimdLevel::Avx512:
+        return countThresholdAvx512<Above>(values, n, threshold);
+      case SimdLevel::Avx2:
+        return countThresholdAvx2<Above>(values, n, threshold);
+      case SimdLevel::Sse2:
+        return countThresholdSse2<Above>(values, n, threshold);
+#endif
+      default:
+        return countThresholdScalar<Above>(values, 0, n, threshold);
+      }
+    }
+  }
+
+  inline SimdLevel activeSimdLevel()
+  {
+    return detail::activeSimdLevelStorage();
+  }
+
+  // Selects the kernel implementation, e.g. to compare implementations in
+  // tests. Levels the CPU does not support are clamped to the detected one.
+  inline void setSimdLevel(SimdLevel level)
+  {
+    const SimdLevel supported = detectSimdLevel();
+    detail::activeSimdLevelStorage() = static_cast<int>(level) < static_cast<int>(supported) ? level : supported;
+  }
+
+  // Index of the first element outside [min_bounds[i], max_bounds[i]], or n
+  template <typename T>
+  size_t findFirstOutsideBounds(const T *test, const T *min_bounds, const T *max_bounds, size_t n)
+  {
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                  "findFirstOutsideBounds only supports float and double types");
+    switch (detail::activeSimdLevelStorage())
+    {
+#if LUMOS_SIMD_X86
+    case SimdLevel::Avx512:
+      return detail::findFirstOutsideBoundsAvx512(test, min_bounds, max_bounds, n);
+    case SimdLevel::Avx2:
+      return detail::findFirstOutsideBoundsAvx2(test, min_bounds, max_bounds, n);
+    case SimdLevel::Sse2:
+      return detail::findFirstOutsideBoundsSse2(test, min_bounds, max_bounds, n);
+#endif
+    default:
+      return detail::findFirstOutsideBoundsScalar(test, min_bounds, max_bounds, 0, n);
+    }
+  }
+
+  // Sum of (a[i] - b[i])^2 in the reduction order described above
+  template <typename T>
+  T sumSquaredDifference(const T *a, const T *b, size_t n)
+  {
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                  "sumSquaredDifference only supports float and double types");
+    switch (detail::activeSimdLevelStorage())
+    {
+#if LUMOS_SIMD_X86
+    case SimdLevel::Avx512:
+      return detail::sumSquaredDifferenceAvx512(a, b, n);
+    case SimdLevel::Avx2:
+      return detail::sumSquaredDifferenceAvx2(a, b, n);
+    case SimdLevel::Sse2:
+      return detail::sumSquaredDifferenceSse2(a, b, n);
+#endif
+    default:
+      return detail::sumSquaredDifferenceScalar(a, b, n);
+    }
+  }
+
+  // out[k] = y0[k] + dy[k] * dx[k] / dt[k] for k < n. Every lane does the
+  // same multiply, divide and add as linearInterpolate, so all
+  // implementations give its bits.
+  template <typename T>
+  void lerpBlock(const T *y0, const T *dy, const T *dx, const T *dt, T *out, size_t n)
+  {
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                  "lerpBlock only supports float and double types");
+    switch (detail::activeSimdLevelStorage())
+    {
+#if LUMOS_SIMD_X86
+    case SimdLevel::Avx512:
+      return detail::lerpBlockAvx512(y0, dy, dx, dt, out, n);
+    case SimdLevel::Avx2:
+      return detail::lerpBlockAvx2(y0, dy, dx, dt, out, n);
+    case SimdLevel::Sse2:
+      return detail::lerpBlockSse2(y0, dy, dx, dt, out, n);
+#endif
+    default:
+      return detail::lerpBlockScalar(y0, dy, dx, dt, out, 0, n);
+    }
+  }
+
+  template <typename T>
+  size_t countAboveThreshold(const T *values, size_t n, T threshold)
+  {
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                  "countAboveThreshold only supports float and double types");
+    return detail::countThreshold<true>(values, n, threshold);
+  }
+
+  template <typename T>
+  size_t countBelowThreshold(const T *values, size_t n, T threshold)
+  {
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                  "countBelowThreshold only supports float and double types");
+    return detail::countThreshold<false>(values, n, threshold);
+  }
+
+}
+
+#if defined(__clang__)
+#pragma float_control(pop)
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
@@ -0,0 +1,274 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <exception>
+#include <algorithm>
+
+namespace lumos
+{
+
+  // A fixed-size pool of worker threads with one task deque per worker.
+  // Workers take tasks from the back of their own deque and steal from the
+  // front of the others' when it runs dry, so uneven task costs are balanced
+  // without a shared queue becoming the bottleneck.
+  //
+  // parallelFor() splits an index range into chunks, spreads them over the
+  // deques and blocks until all have run. The calling thread executes chunks
+  // as well, so calling parallelFor() from inside a task does not deadlock.
+  // submit() queues a single task and returns a future.
+  class ThreadPool
+  {
+  public:
+    explicit ThreadPool(size_t thread_count = defaultThreadCount())
+        : pending_(0), stop_(false), next_queue_(0)
+    {
+      thread_count = std::max<size_t>(1, thread_count);
+      for (size_t i = 0; i < thread_count; ++i)
+      {
+        queues_.push_back(std::make_unique<WorkQueue>());
+      }
+      threads_.reserve(thread_count);
+      for (size_t i = 0; i < thread_count; ++i)
+      {
+        threads_.emplace_back([this, i]
+                              { workerLoop(i); });
+      }
+    }
+
+    ~ThreadPool()
+    {
+      {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        stop_ = true;
+      }
+      wake_.notify_all();
+      for (std::thread &thread : threads_)
+      {
+        thread.join();
+      }
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    static size_t defaultThreadCount()
+    {
+      return std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    size_t size() const
+    {
+      return threads_.size();
+    }
+
+    // Calls function(i) for every i in [0, count). Indices are grouped into
+    // chunks of at least min_chunk_size. The first exception thrown by any
+    // call is rethrown once all chunks have finished.
+    template <typename Function>
+    void parallelFor(size_t count, Function function, size_t min_chunk_size = 1)
+    {
+      if (count == 0)
+      {
+        return;
+      }
+
+      // A few chunks per worker leaves room for stealing to even out the load
+      const size_t target_chunks = threads_.size() * kChunksPerThread;
+      const size_t chunk_size = std::max(std::max<size_t>(1, min_chunk_size),
+                                         (count + target_chunks - 1) / target_chunks);
+      const size_t chunk_count = (count + chunk_size - 1) / chunk_size;
+
+      auto batch = std::make_shared<Batch>(chunk_count);
+      std::vector<std::function<void()>> tasks;
+      tasks.reserve(chunk_count);
+      for (size_t c = 0; c < chunk_count; ++c)
+      {
+        const size_t begin = c * chunk_size;
+        const size_t end = std::min(count, begin + chunk_size);
+        tasks.emplace_back([batch, begin, end, &function]
+                           {
+                             if (!batch->failed.load(std::memory_order_relaxed))
+                             {
+                               try
+                               {
+                                 for (size_t i = begin; i < end; ++i)
+                                 {
+                                   function(i);
+                                 }
+                               }
+                               catch (...)
+                               {
+                                 batch->fail(std::current_exception());
+                               }
+                             }
+                             batch->finishOne(); });
+      }
+      enqueue(tasks);
+
+      // Help out until the batch is done, then wait for chunks still running
+      while (batch->remaining.load(std::memory_order_acquire) > 0)
+      {
+        if (!runOneTask(queues_.size()))
+        {
+          std::unique_lock<std::mutex> lock(batch->mutex);
+          batch->done.wait(lock, [&]
+                           { return batch->remaining.load(std::memory_order_acquire) == 0; });
+        }
+      }
+
+      if (batch->error)
+      {
+        std::rethrow_exception(batch->error);
+      }
+    }
+
+    // Runs function() on a worker and returns a future for its result
+    template <typename Function>
+    auto submit(Function function) -> std::future<decltype(function())>
+    {
+      using Result = decltype(function());
+      auto task = std::make_shared<std::packaged_task<Result()>>(std::move(function));
+      std::future<Result> future = task->get_future();
+      std::vector<std::function<void()>> tasks;
+      tasks.emplace_back([task]
+                         { (*task)(); });
+      enqueue(tasks);
+      return future;
+    }
+
+  private:
+    static constexpr size_t kChunksPerThread = 8;
+
+    struct WorkQueue
+    {
+      std::mutex mutex;
+      std::deque<std::function<void()>> tasks;
+    };
+
+    struct Batch
+    {
+      explicit Batch(size_t chunk_count) : remaining(chunk_count), failed(false) {}
+
+      void fail(std::exception_ptr exception)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error)
+        {
+          error = exception;
+        }
+        failed.store(true, std::memory_order_relaxed);
+      }
+
+      void finishOne()
+      {
+        if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          done.notify_all();
+        }
+      }
+
+      std::atomic<size_t> remaining;
+      std::atomic<bool> failed;
+      std::exception_ptr error;
+      std::mutex mutex;
+      std::condition_variable done;
+    };
+
+    void enqueue(std::vector<std::function<void()>> &tasks)
+    {
+      // Counted before the tasks become visible so pending_ never drops below
+      // the number of queued tasks
+      pending_.fetch_add(tasks.size(), std::memory_order_relaxed);
+
+      const size_t first = next_queue_.fetch_add(1, std::memory_order_relaxed);
+      for (size_t t = 0; t < tasks.size(); ++t)
+      {
+        WorkQueue &queue = *queues_[(first + t) % queues_.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(tasks[t]));
+      }
+
+      // A worker that saw pending_ == 0 under wake_mutex_ is either already
+      // waiting or will see the new count, so the notify cannot be lost
+      {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+      }
+      wake_.notify_all();
+    }
+
+    // Runs one task from the own deque of worker `index`, or one stolen from
+    // another deque. An index past the last worker only steals.
+    bool runOneTask(size_t index)
+    {
+      std::function<void()> task;
+
+      if (index < queues_.size())
+      {
+        WorkQueue &own = *queues_[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty())
+        {
+          task = std::move(own.tasks.back());
+          own.tasks.pop_back();
+        }
+      }
+
+      for (size_t k = 1; !task && k <= queues_.size(); ++k)
+      {
+        WorkQueue &victim = *queues_[(index + k) % queues_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty())
+        {
+          task = std::move(victim.tasks.front());
+          victim.tasks.pop_front();
+        }
+      }
+
+      if (!task)
+      {
+        return false;
+      }
+
+      pending_.fetch_sub(1, std::memory_order_relaxed);
+      task();
+      return true;
+    }
+
+    void workerLoop(size_t index)
+    {
+      while (true)
+      {
+        if (runOneTask(index))
+        {
+          continue;
+        }
+
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        wake_.wait(lock, [&]
+                   { return stop_ || pending_.load(std::memory_order_relaxed) > 0; });
+        if (stop_ && pending_.load(std::memory_order_relaxed) == 0)
+        {
+          return;
+        }
+      }
+    }
+
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    std::vector<std::thread> threads_;
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    std::atomic<size_t> pending_;
+    bool stop_;
+    std::atomic<size_t> next_queue_;
+  };
+
+}
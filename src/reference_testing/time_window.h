@@ -0,0 +1,88 @@
+#pragma once
+
+#include <type_traits>
+#include <stdexcept>
+#include <cstddef>
+
+#include "reference_testing/ranges.h"
+
+namespace lumos
+{
+
+  // Half-open range of sample indices [begin, end)
+  struct IndexRange
+  {
+    size_t begin;
+    size_t end;
+
+    size_t size() const { return end - begin; }
+    bool empty() const { return begin == end; }
+  };
+
+  namespace detail
+  {
+    // First index in [0, count) for which before(i) is false, assuming
+    // before() is true for a prefix of the indices only
+    template <typename Before>
+    size_t partitionPoint(size_t count, Before before)
+    {
+      size_t low = 0;
+      size_t high = count;
+      while (low < high)
+      {
+        const size_t middle = low + (high - low) / 2;
+        if (before(middle))
+        {
+          low = middle + 1;
+        }
+        else
+        {
+          high = middle;
+        }
+      }
+      return low;
+    }
+
+    // Window of samples with start <= time[i] <= stop, looked up by binary
+    // search through timeAt(i) so the timebase is probed O(log n) times
+    template <typename T, typename TimeAt>
+    IndexRange findTimeWindow(size_t count, T start, T stop, TimeAt time_at)
+    {
+      static_assert(std::is_arithmetic_v<T>, "findTimeWindow requires an arithmetic timebase");
+
+      if (stop < start)
+      {
+        throw std::invalid_argument("Time window must not end before it starts");
+      }
+
+      const size_t begin = partitionPoint(count, [&](size_t i)
+                                          { return time_at(i) < start; });
+      const size_t end = begin + partitionPoint(count - begin, [&](size_t i)
+                                                { return !(stop < time_at(begin + i)); });
+      return {begin, end};
+    }
+  }
+
+  // Indices of the samples of a sorted timebase that lie within [start, stop].
+  // Use the result to slice reference channels sharing the timebase, so a
+  // check on a time window only reads and scans that window.
+  template <typename TimeRange, typename = EnableIfRange<TimeRange>>
+  IndexRange findTimeWindow(const TimeRange &time, RangeValueType<TimeRange> start, RangeValueType<TimeRange> stop)
+  {
+    return detail::findTimeWindow(time.size(), start, stop, [&](size_t i)
+                                  { return time[i]; });
+  }
+
+  // View of the elements of a contiguous range within an index window
+  template <typename Range>
+  auto windowOf(const Range &range, const IndexRange &window)
+      -> Span<std::remove_pointer_t<decltype(range.data())>>
+  {
+    if (window.begin > window.end || window.end > range.size())
+    {
+      throw std::invalid_argument("Window exceeds the range size");
+    }
+    return Span<std::remove_pointer_t<decltype(range.data())>>(range.data() + window.begin, window.size());
+  }
+
+}
@@ -0,0 +1,237 @@
+#pragma once
+
+#include <vector>
+#include <type_traits>
+#include <limits>
+#include <algorithm>
+
+#include "reference_testing/ranges.h"
+#include "reference_testing/bounds_checker.h"
+
+namespace lumos
+{
+
+  // Which fields of a ViolationReport to collect. With everything disabled
+  // the scan stops at the first violation and costs the same as the plain
+  // isWithinBounds; each enabled field makes the scan run to the end.
+  struct ViolationReportOptions
+  {
+    bool count_violations = true;
+    bool worst_margin = true;
+    bool longest_run = true;
+
+    static ViolationReportOptions firstViolationOnly()
+    {
+      return ViolationReportOptions{false, false, false};
+    }
+  };
+
+  template <typename T>
+  struct ViolationReport
+  {
+    static constexpr size_t kNoViolation = std::numeric_limits<size_t>::max();
+
+    bool passed = true;
+    // Index of the first sample outside the bounds, kNoViolation if none
+    size_t first_index = kNoViolation;
+    // Test time of the first violation, NaN if none or for index-based checks
+    T first_time = std::numeric_limits<T>::quiet_NaN();
+    size_t violation_count = 0;
+    // Largest distance of a sample beyond its bound and where it occurred
+    T worst_margin = T(0);
+    size_t worst_index = kNoViolation;
+    size_t longest_run = 0;
+  };
+
+  namespace detail
+  {
+    template <typename T>
+    class ViolationCollector
+    {
+    public:
+      explicit ViolationCollector(const ViolationReportOptions &options)
+          : options_(options), scan_all_(options.count_violations || options.worst_margin || options.longest_run),
+            current_run_(0)
+      {
+      }
+
+      // Returns false once nothing more needs to be collected
+      bool add(size_t index, T test_value, T min_bound, T max_bound)
+      {
+        if (!(test_value < min_bound || test_value > max_bound))
+        {
+          current_run_ = 0;
+          return true;
+        }
+
+        if (report_.passed)
+        {
+          report_.passed = false;
+          report_.first_index = index;
+        }
+
+        if (options_.count_violations)
+        {
+          report_.violation_count++;
+        }
+
+        if (options_.worst_margin)
+        {
+          const T margin = test_value < min_bound ? min_bound - test_value : test_value - max_bound;
+          if (margin > report_.worst_margin)
+          {
+            report_.worst_margin = margin;
+            report_.worst_index = index;
+          }
+        }
+
+        if (options_.longest_run)
+        {
+          current_run_++;
+          report_.longest_run = std::max(report_.longest_run, current_run_);
+        }
+
+        return scan_all_;
+      }
+
+      // Samples before this one were in bounds without being passed to add()
+      void skipInBounds()
+      {
+        current_run_ = 0;
+      }
+
+      bool scanAll() const { return scan_all_; }
+      ViolationReport<T> &report() { return report_; }
+
+    private:
+      ViolationReportOptions options_;
+      bool scan_all_;
+      size_t current_run_;
+      ViolationReport<T> report_;
+    };
+  }
+
+  // Same check as isWithinBounds(test_vector, min_bounds, max_bounds) that
+  // also says where and by how much it failed, collected in the same pass.
+  // Violation-free stretches of contiguous data are skipped with the SIMD
+  // bounds kernel. Size mismatches give a failed report without a first index.
+  template <typename TestRange, typename BoundRange>
+  ViolationReport<RangeValueType<TestRange>> checkWithinBounds(
+      const TestRange &test_vector,
+      const BoundRange &min_bounds,
+      const BoundRange &max_bounds,
+      const ViolationReportOptions &options = ViolationReportOptions())
+  {
+    using T = RangeValueType<TestRange>;
+    static_assert(std::is_same_v<T, RangeValueType<BoundRange>>,
+                  "checkWithinBounds requires test and bound ranges of the same value type");
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                  "checkWithinBounds only supports float and double types");
+
+    detail::ViolationCollector<T> collector(options);
+    if (test_vector.size() != min_bounds.size() || test_vector.size() != max_bounds.size())
+    {
+      collector.report().passed = false;
+      return collector.report();
+    }
+
+    const size_t n = test_vector.size();
+    if constexpr (IsContiguousRange<TestRange>::value && IsContiguousRange<BoundRange>::value)
+    {
+      const T *test = test_vector.data();
+      const T *min_data = min_bounds.data();
+      const T *max_data = max_bounds.data();
+
+      size_t i = 0;
+      while (i < n)
+      {
+        // Jump to the next violation, then walk its run sample by sample
+        const size_t next = i + findFirstOutsideBounds(test + i, min_data + i, max_data + i, n - i);
+        if (next == n)
+        {
+          break;
+        }
+        if (next > i)
+        {
+          collector.skipInBounds();
+        }
+
+        i = next;
+        bool in_run = true;
+        while (i < n && in_run)
+        {
+          if (!collector.add(i, test[i], min_data[i], max_data[i]))
+          {
+            return collector.report();
+          }
+          in_run = test[i] < min_data[i] || test[i] > max_data[i];
+          ++i;
+        }
+      }
+    }
+    else
+    {
+      for (size_t i = 0; i < n; ++i)
+      {
+        if (!collector.add(i, test_vector[i], min_bounds[i], max_bounds[i]))
+        {
+          break;
+        }
+      }
+    }
+
+    return collector.report();
+  }
+
+  // Time-based counterpart of checkWithinBounds, the report also carries the
+  // test time of the first violation
+  template <typename TestRange, typename BoundRange>
+  ViolationReport<RangeValueType<TestRange>> checkWithinBounds(
+      const TestRange &test_vector_time,
+      const TestRange &test_vector,
+      const BoundRange &min_bounds_time,
+      const BoundRange &min_bounds,
+      const BoundRange &max_bounds_time,
+      const BoundRange &max_bounds,
+      const ViolationReportOptions &options = ViolationReportOptions())
+  {
+    using T = RangeValueType<TestRange>;
+    static_assert(std::is_same_v<T, RangeValueType<BoundRange>>,
+                  "checkWithinBounds requires test and bound ranges of the same value type");
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                  "checkWithinBounds only supports float and double types");
+
+    detail::ViolationCollector<T> collector(options);
+    if (test_vector_time.size() != test_vector.size())
+    {
+      collector.report().passed = false;
+      return collector.report();
+    }
+
+    if (min_bounds_time.size() != min_bounds.size() ||
+        max_bounds_time.size() != max_bounds.size())
+    {
+      collector.report().passed = false;
+      return collector.report();
+    }
+
+    if (test_vector.empty())
+    {
+      return collector.report();
+    }
+
+    detail::visitTimeBounds(test_vector_time, test_vector, min_bounds_time, min_bounds,
+                            max_bounds_time, max_bounds,
+                            isSortedTimeVector(min_bounds_time) && isSortedTimeVector(max_bounds_time),
+                            [&](size_t index, T test_value, T min_bound, T max_bound)
+                            { return collector.add(index, test_value, min_bound, max_bound); });
+
+    ViolationReport<T> &report = collector.report();
+    if (!report.passed)
+    {
+      report.first_time = test_vector_time[report.first_index];
+    }
+    return report;
+  }
+
+}
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <string>
+
+namespace lumos
+{
+
+    // Streaming XXH64. Produces the same digests as the reference xxHash
+    // implementation, so hashes can be cross-checked with the xxhsum tool.
+    //
+    //   XXHash64 hasher(seed);
+    //   hasher.update(chunk.data(), chunk.size() * sizeof(double));
+    //   uint64_t digest = hasher.digest();
+    class XXHash64
+    {
+    public:
+        explicit XXHash64(uint64_t seed = 0)
+            : seed_(seed), total_length_(0), buffered_(0),
+              v1_(seed + kPrime1 + kPrime2), v2_(seed + kPrime2), v3_(seed), v4_(seed - kPrime1)
+        {
+        }
+
+        void update(const void *data, size_t length)
+        {
+            const unsigned char *input = static_cast<const unsigned char *>(data);
+            total_length_ += length;
+
+            if (buffered_ + length < kStripe)
+            {
+                std::memcpy(buffer_ + buffered_, input, length);
+                buffered_ += length;
+                return;
+            }
+
+            if (buffered_ > 0)
+            {
+                const size_t fill = kStripe - buffered_;
+                std::memcpy(buffer_ + buffered_, input, fill);
+                consumeStripe(buffer_);
+                input += fill;
+                length -= fill;
+                buffered_ = 0;
+            }
+
+            while (length >= kStripe)
+            {
+                consumeStripe(input);
+                input += kStripe;
+                length -= kStripe;
+            }
+
+            std::memcpy(buffer_, input, length);
+            buffered_ = length;
+        }
+
+        uint64_t digest() const
+        {
+            uint64_t hash;
+            if (total_length_ >= kStripe)
+            {
+                hash = rotl(v1_, 1) + rotl(v2_, 7) + rotl(v3_, 12) + rotl(v4_, 18);
+                hash = mergeRound(hash, v1_);
+                hash = mergeRound(hash, v2_);
+                hash = mergeRound(hash, v3_);
+                hash = mergeRound(hash, v4_);
+            }
+            else
+            {
+                hash = seed_ + kPrime5;
+            }
+            hash += total_length_;
+
+            const unsigned char *tail = buffer_;
+            size_t remaining = buffered_;
+            while (remaining >= 8)
+            {
+                hash ^= round(0, read64(tail));
+                hash = rotl(hash, 27) * kPrime1 + kPrime4;
+                tail += 8;
+                remaining -= 8;
+            }
+            if (remaining >= 4)
+            {
+                hash ^= static_cast<uint64_t>(read32(tail)) * kPrime1;
+                hash = rotl(hash, 23) * kPrime2 + kPrime3;
+                tail += 4;
+                remaining -= 4;
+            }
+            while (remaining > 0)
+            {
+                hash ^= static_cast<uint64_t>(*tail) * kPrime5;
+                hash = rotl(hash, 11) * kPrime1;
+                tail++;
+                remaining--;
+            }
+
+            hash ^= hash >> 33;
+            hash *= kPrime2;
+            hash ^= hash >> 29;
+            hash *= kPrime3;
+            hash ^= hash >> 32;
+            return hash;
+        }
+
+        static uint64_t hash(const void *data, size_t length, uint64_t seed = 0)
+        {
+            XXHash64 hasher(seed);
+            hasher.update(data, length);
+            return hasher.digest();
+        }
+
+    private:
+        static constexpr uint64_t kPrime1 = 11400714785074694791ULL;
+        static constexpr uint64_t kPrime2 = 14029467366897019727ULL;
+        static constexpr uint64_t kPrime3 = 1609587929392839161ULL;
+        static constexpr uint64_t kPrime4 = 9650029242287828579ULL;
+        static constexpr uint64_t kPrime5 = 2870177450012600261ULL;
+        static constexpr size_t kStripe = 32;
+
+        static uint64_t rotl(uint64_t value, int bits)
+        {
+            return (value << bits) | (value >> (64 - bits));
+        }
+
+        static uint64_t round(uint64_t accumulator, uint64_t input)
+        {
+            accumulator += input * kPrime2;
+            accumulator = rotl(accumulator, 31);
+            return accumulator * kPrime1;
+        }
+
+        static uint64_t mergeRound(uint64_t accumulator, uint64_t value)
+        {
+            accumulator ^= round(0, value);
+            return accumulator * kPrime1 + kPrime4;
+        }
+
+        // Input is read as little endian as the xxHash specification requires
+        static uint64_t read64(const unsigned char *input)
+        {
+            uint64_t value;
+            std::memcpy(&value, input, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            value = __builtin_bswap64(value);
+#endif
+            return value;
+        }
+
+        static uint32_t read32(const unsigned char *input)
+        {
+            uint32_t value;
+            std::memcpy(&value, input, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            value = __builtin_bswap32(value);
+#endif
+            return value;
+        }
+
+        void consumeStripe(const unsigned char *stripe)
+        {
+            v1_ = round(v1_, read64(stripe));
+            v2_ = round(v2_, read64(stripe + 8));
+            v3_ = round(v3_, read64(stripe + 16));
+            v4_ = round(v4_, read64(stripe + 24));
+        }
+
+        uint64_t seed_;
+        uint64_t total_length_;
+        size_t buffered_;
+        uint64_t v1_, v2_, v3_, v4_;
+        unsigned char buffer_[kStripe];
+    };
+
+    inline std::string hashToHex(uint64_t hash)
+    {
+        static const char digits[] = "0123456789abcdef";
+        std::string hex(16, '0');
+        for (size_t i = 0; i < 16; ++i)
+        {
+            hex[15 - i] = digits[(hash >> (4 * i)) & 0xF];
+        }
+        return hex;
+    }
+
+}
@@ -103,6 +103,24 @@ TEST_F(ApplicationTest, SensorDataValidation)
     EXPECT_TRUE(isMeanDifferenceWithinThreshold(sensor_y, ref_y, 0.05)) << "Sensor Y mean drift detected";
 }
 
+TEST_F(ApplicationTest, FusedSensorDataValidation)
+{
+    // Application use case: Same checks as SensorDataValidation, evaluated in one pass per channel
+
+    std::vector<double> x_min(sensor_x.size(), -1.5);
+    std::vector<double> x_max(sensor_x.size(), 1.5);
+
+    CheckSet<double> checks;
+    checks.addWithinBounds("physical limits", x_min, x_max)
+        .addVarianceWithinThreshold("variance", 0.1)
+        .addMeanDifferenceWithinThreshold("mean drift", 0.05);
+
+    for (const CheckResult<double> &result : checks.evaluate(sensor_x, ref_x))
+    {
+        EXPECT_TRUE(result.passed) << "Sensor X check failed: " << result.name;
+    }
+}
+
 TEST_F(ApplicationTest, ControlSystemValidation)
 {
     // Application use case: Validate control system performance
@@ -45,6 +45,19 @@ TEST_F(Corridor2DTest, BoundaryPoints)
     EXPECT_TRUE(isWithin2DCorridor(x_boundary, y_boundary, x_left, y_left, x_right, y_right));
 }
 
+TEST_F(Corridor2DTest, LeftBoundaryPoints)
+{
+    // On a left segment, on a left vertex and on the left end points
+    std::vector<double> x_left_boundary = {0.0, 0.0, 0.0, 0.0};
+    std::vector<double> y_left_boundary = {1.5, 2.0, 0.0, 3.0};
+    EXPECT_TRUE(isWithin2DCorridor(x_left_boundary, y_left_boundary, x_left, y_left, x_right, y_right));
+
+    // Just beyond the left boundary is outside
+    std::vector<double> x_beyond = {-1e-9};
+    std::vector<double> y_beyond = {1.5};
+    EXPECT_FALSE(isWithin2DCorridor(x_beyond, y_beyond, x_left, y_left, x_right, y_right));
+}
+
 TEST_F(Corridor2DTest, ErrorCases)
 {
     std::vector<double> mismatched_x = {1.0, 2.0};
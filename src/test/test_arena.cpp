@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include "reference_testing/reference_testing.h"
+
+using namespace lumos;
+
+// Counts every heap allocation made by this test executable. The replacement
+// operators pair aligned_alloc with free, which GCC cannot see through.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+namespace
+{
+    std::atomic<size_t> heap_allocations(0);
+
+    void *countedAllocation(size_t size, size_t alignment)
+    {
+        heap_allocations++;
+        size = (std::max<size_t>(size, 1) + alignment - 1) / alignment * alignment;
+        if (void *data = std::aligned_alloc(alignment, size))
+        {
+            return data;
+        }
+        throw std::bad_alloc();
+    }
+
+    void release(void *data)
+    {
+        std::free(data);
+    }
+}
+
+void *operator new(size_t size) { return countedAllocation(size, alignof(std::max_align_t)); }
+void *operator new[](size_t size) { return countedAllocation(size, alignof(std::max_align_t)); }
+void *operator new(size_t size, std::align_val_t alignment) { return countedAllocation(size, static_cast<size_t>(alignment)); }
+void *operator new[](size_t size, std::align_val_t alignment) { return countedAllocation(size, static_cast<size_t>(alignment)); }
+void operator delete(void *data) noexcept { release(data); }
+void operator delete[](void *data) noexcept { release(data); }
+void operator delete(void *data, size_t) noexcept { release(data); }
+void operator delete[](void *data, size_t) noexcept { release(data); }
+void operator delete(void *data, std::align_val_t) noexcept { release(data); }
+void operator delete[](void *data, std::align_val_t) noexcept { release(data); }
+void operator delete(void *data, size_t, std::align_val_t) noexcept { release(data); }
+void operator delete[](void *data, size_t, std::align_val_t) noexcept { release(data); }
+
+TEST(MonotonicArenaTest, AllocatesAlignedAndResets)
+{
+    MonotonicArena arena(1024);
+
+    void *first = arena.allocate(10, 1);
+    void *aligned = arena.allocate(64, 64);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(aligned) % 64, 0u);
+    EXPECT_NE(first, aligned);
+    EXPECT_EQ(arena.blockCount(), 1u);
+
+    // Requests larger than a block get a block of their own
+    void *large = arena.allocate(10000, 16);
+    EXPECT_NE(large, nullptr);
+    EXPECT_EQ(arena.blockCount(), 2u);
+    EXPECT_GE(arena.used(), 10074u);
+
+    const size_t capacity = arena.capacity();
+    arena.reset();
+    EXPECT_EQ(arena.used(), 0u);
+    EXPECT_EQ(arena.blockCount(), 1u);
+    EXPECT_EQ(arena.capacity(), capacity);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(arena.allocate(8, 8)) % MonotonicArena::kBlockAlignment, 0u);
+
+    // The merged block holds the same pattern again without growing
+    const size_t upstream = arena.upstreamAllocations();
+    arena.reset();
+    EXPECT_NE(arena.allocate(10, 1), nullptr);
+    EXPECT_NE(arena.allocate(64, 64), nullptr);
+    EXPECT_NE(arena.allocate(10000, 16), nullptr);
+    EXPECT_EQ(arena.upstreamAllocations(), upstream);
+
+    ArenaVector<int> values(&arena);
+    values.assign(100, 7);
+    EXPECT_EQ(values[99], 7);
+}
+
+class ArenaSteadyStateTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        for (size_t i = 0; i < 20000; ++i)
+        {
+            const double t = 0.001 * static_cast<double>(i);
+            time.push_back(t);
+            x.push_back(std::sin(t));
+            x_min.push_back(std::sin(t) - 0.1);
+            x_max.push_back(std::sin(t) + 0.1);
+        }
+        saveBinaryVector(x, "arena_x.bin");
+        saveBinaryVector(time, "arena_time.bin");
+    }
+
+    void TearDown() override
+    {
+        std::remove("arena_x.bin");
+        std::remove("arena_time.bin");
+    }
+
+    std::vector<double> time, x, x_min, x_max;
+};
+
+TEST_F(ArenaSteadyStateTest, RunsWithoutHeapAllocations)
+{
+    const std::string x_file = "arena_x.bin";
+    const std::string time_file = "arena_time.bin";
+
+    CheckSet<double> checks;
+    checks.addWithinBounds("x", x_min, x_max)
+        .addVarianceWithinThreshold("var", 0.01)
+        .addConsecutiveSamplesAboveThreshold("run", 0.5, 100);
+
+    MonotonicArena arena;
+    std::vector<CheckResult<double>> results;
+    size_t allocations_per_run = 0;
+
+    for (size_t run = 0; run < 4; ++run)
+    {
+        const size_t before = heap_allocations.load();
+        arena.reset();
+
+        ArenaVector<double> loaded_x = loadBinaryVector<double>(x_file, ArenaAllocator<double>(&arena));
+        ArenaVector<double> loaded_time = loadBinaryVector<double>(time_file, ArenaAllocator<double>(&arena));
+
+        ArenaVector<double> query(loaded_time.size() / 2, &arena);
+        for (size_t i = 0; i < query.size(); ++i)
+            query[i] = loaded_time[2 * i] + 0.0005;
+        ArenaVector<double> resampled(query.size(), &arena);
+        resample(query, loaded_time, loaded_x, resampled);
+
+        checks.evaluate(loaded_x, loaded_x, results, &arena);
+        allocations_per_run = heap_allocations.load() - before;
+
+        ASSERT_EQ(results.size(), 3u);
+        EXPECT_TRUE(results[0].passed);
+        EXPECT_TRUE(results[1].passed);
+        EXPECT_TRUE(results[2].passed);
+        EXPECT_NEAR(resampled[10], std::sin(0.0205), 1e-6);
+        EXPECT_EQ(std::vector<double>(loaded_x.begin(), loaded_x.end()), x);
+    }
+
+    // Only the first runs grow the arena
+    EXPECT_EQ(allocations_per_run, 0u);
+}
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <string>
+#include <set>
+#include <cstdio>
+#include "reference_testing/reference_testing.h"
+
+using namespace lumos;
+
+class AsyncLoaderTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        for (size_t c = 0; c < 12; ++c)
+        {
+            std::vector<double> channel(1000 + 100 * c);
+            for (size_t i = 0; i < channel.size(); ++i)
+            {
+                channel[i] = static_cast<double>(c) + 0.001 * static_cast<double>(i);
+            }
+            filenames.push_back("async_channel_" + std::to_string(c) + ".bin");
+            saveBinaryVector(channel, filenames.back());
+            channels.push_back(channel);
+        }
+    }
+
+    void TearDown() override
+    {
+        for (const std::string &filename : filenames)
+        {
+            std::remove(filename.c_str());
+        }
+        std::remove("async_container.lrc");
+    }
+
+    std::vector<std::string> filenames;
+    std::vector<std::vector<double>> channels;
+};
+
+TEST_F(AsyncLoaderTest, LoadsSingleFiles)
+{
+    AsyncReferenceLoader loader(4);
+    std::shared_future<std::vector<double>> first = loader.loadAsync<double>(filenames[0]);
+    std::shared_future<std::vector<double>> last = loader.loadAsync<double>(filenames.back());
+
+    EXPECT_EQ(last.get(), channels.back());
+    EXPECT_EQ(first.get(), channels[0]);
+
+    std::shared_future<std::vector<double>> missing = loader.loadAsync<double>("async_missing.bin");
+    EXPECT_THROW(missing.get(), std::runtime_error);
+
+    std::shared_future<std::vector<float>> wrong_type = loader.loadAsync<float>(filenames[0]);
+    EXPECT_THROW(wrong_type.get(), std::runtime_error);
+}
+
+TEST_F(AsyncLoaderTest, BatchInCompletionOrder)
+{
+    AsyncReferenceLoader loader(3);
+    std::vector<std::string> names(filenames);
+    names.push_back("async_missing.bin");
+    LoadBatch<double> batch = loader.loadAll<double>(names);
+
+    ASSERT_EQ(batch.size(), names.size());
+    std::set<size_t> seen;
+    for (size_t i = batch.nextReady(); i != LoadBatch<double>::kDone; i = batch.nextReady())
+    {
+        EXPECT_TRUE(seen.insert(i).second);
+        if (i == filenames.size())
+        {
+            EXPECT_THROW(batch.get(i), std::runtime_error);
+        }
+        else
+        {
+            // Checks can start on a channel as soon as it arrives
+            EXPECT_TRUE(hasAtLeastNSamplesAboveThreshold(batch.get(i), static_cast<double>(i), 1));
+            EXPECT_EQ(batch.get(i), channels[i]);
+        }
+    }
+    EXPECT_EQ(seen.size(), names.size());
+    EXPECT_EQ(batch.nextReady(), LoadBatch<double>::kDone);
+}
+
+TEST_F(AsyncLoaderTest, LoadsContainerChannels)
+{
+    {
+        ReferenceContainerWriter writer("async_container.lrc");
+        for (size_t c = 0; c < channels.size(); ++c)
+        {
+            writer.addChannel("c" + std::to_string(c), channels[c],
+                              c % 2 == 0 ? ContainerEncoding::Raw : ContainerEncoding::XorFloat);
+        }
+    }
+
+    ReferenceContainer container("async_container.lrc");
+    AsyncReferenceLoader loader;
+
+    EXPECT_EQ(loader.loadAsync<double>(container, "c3").get(), channels[3]);
+    EXPECT_THROW(loader.loadAsync<double>(container, "missing"), std::runtime_error);
+
+    std::vector<std::string> names;
+    for (size_t c = 0; c < channels.size(); ++c)
+    {
+        names.push_back("c" + std::to_string(c));
+    }
+    LoadBatch<double> batch = loader.loadAll<double>(container, names);
+    for (size_t i = batch.nextReady(); i != LoadBatch<double>::kDone; i = batch.nextReady())
+    {
+        EXPECT_EQ(batch.get(i), channels[i]);
+    }
+}
+
+TEST(ThreadPoolSubmitTest, ReturnsResult)
+{
+    ThreadPool pool(2);
+    std::future<int> answer = pool.submit([]
+                                          { return 42; });
+    std::future<void> failing = pool.submit([]
+                                            { throw std::runtime_error("failed"); });
+    EXPECT_EQ(answer.get(), 42);
+    EXPECT_THROW(failing.get(), std::runtime_error);
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <cmath>
+#include <atomic>
+#include <stdexcept>
+#include "reference_testing/reference_testing.h"
+
+using namespace lumos;
+
+TEST(ThreadPoolTest, VisitsEveryIndexOnce)
+{
+    ThreadPool pool(4);
+    std::vector<std::atomic<int>> visits(10007);
+    pool.parallelFor(visits.size(), [&](size_t i)
+                     { visits[i]++; });
+
+    for (const auto &count : visits)
+    {
+        EXPECT_EQ(count.load(), 1);
+    }
+}
+
+TEST(ThreadPoolTest, EmptyRangeAndSingleThread)
+{
+    ThreadPool pool(1);
+    EXPECT_EQ(pool.size(), 1u);
+
+    size_t calls = 0;
+    pool.parallelFor(0, [&](size_t)
+                     { calls++; });
+    EXPECT_EQ(calls, 0u);
+
+    pool.parallelFor(100, [&](size_t)
+                     { calls++; }, 1000);
+    EXPECT_EQ(calls, 100u);
+}
+
+TEST(ThreadPoolTest, NestedParallelFor)
+{
+    ThreadPool pool(2);
+    std::atomic<size_t> total(0);
+    pool.parallelFor(8, [&](size_t)
+                     { pool.parallelFor(100, [&](size_t)
+                                        { total++; }); });
+    EXPECT_EQ(total.load(), 800u);
+}
+
+TEST(ThreadPoolTest, RethrowsException)
+{
+    ThreadPool pool(4);
+    EXPECT_THROW(pool.parallelFor(1000, [](size_t i)
+                                  {
+                                      if (i == 500)
+                                          throw std::runtime_error("run failed"); }),
+                 std::runtime_error);
+
+    // The pool stays usable after a failed batch
+    std::atomic<size_t> calls(0);
+    pool.parallelFor(1000, [&](size_t)
+                     { calls++; });
+    EXPECT_EQ(calls.load(), 1000u);
+}
+
+class BatchEvaluatorTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        const size_t n = 2000;
+        for (size_t i = 0; i < n; ++i)
+        {
+            double t = 0.01 * static_cast<double>(i);
+            reference.push_back(std::sin(t));
+            min_bounds.push_back(std::sin(t) - 0.5);
+            max_bounds.push_back(std::sin(t) + 0.5);
+        }
+
+        // Every third run drifts out of bounds
+        for (size_t run = 0; run < 300; ++run)
+        {
+            std::vector<double> test(reference);
+            double offset = (run % 3 == 0) ? 0.8 : 0.01 * static_cast<double>(run % 10);
+            for (size_t i = n / 2; i < n; ++i)
+            {
+                test[i] += offset;
+            }
+            runs.push_back(test);
+        }
+
+        checks.addWithinBounds("bounds", min_bounds, max_bounds)
+            .addVarianceWithinThreshold("variance", 0.1)
+            .addSamplesAboveThreshold("peaks", 0.9, 10);
+    }
+
+    std::vector<double> reference, min_bounds, max_bounds;
+    std::vector<std::vector<double>> runs;
+    CheckSet<double> checks;
+};
+
+TEST_F(BatchEvaluatorTest, MatchesSerialEvaluation)
+{
+    ThreadPool pool(4);
+    BatchEvaluator<double> batch(checks, pool);
+    std::vector<RunResult<double>> results = batch.evaluate(runs, reference);
+
+    ASSERT_EQ(results.size(), runs.size());
+    for (size_t run = 0; run < runs.size(); ++run)
+    {
+        std::vector<CheckResult<double>> serial = checks.evaluate(runs[run], reference);
+        ASSERT_EQ(results[run].checks.size(), serial.size());
+
+        bool passed = true;
+        for (size_t c = 0; c < serial.size(); ++c)
+        {
+            EXPECT_EQ(results[run].checks[c].passed, serial[c].passed);
+            EXPECT_EQ(results[run].checks[c].value, serial[c].value);
+            passed = passed && serial[c].passed;
+        }
+        EXPECT_EQ(results[run].passed, passed);
+        EXPECT_EQ(results[run].passed, run % 3 != 0);
+    }
+}
+
+TEST_F(BatchEvaluatorTest, EvaluateRunsWithFreeFunction)
+{
+    ThreadPool pool(3);
+    std::vector<bool> verdicts = evaluateRuns(pool, runs.size(), [&](size_t run)
+                                              { return isWithinBounds(runs[run], min_bounds, max_bounds); });
+
+    ASSERT_EQ(verdicts.size(), runs.size());
+    for (size_t run = 0; run < runs.size(); ++run)
+    {
+        EXPECT_EQ(verdicts[run], isWithinBounds(runs[run], min_bounds, max_bounds));
+    }
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include "reference_testing/reference_testing.h"
+
+using namespace lumos;
+
+class BinaryStreamingTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        for (int i = 0; i < 1000; ++i)
+        {
+            recording.push_back(0.5 * i);
+        }
+    }
+
+    void TearDown() override
+    {
+        std::remove("streamed_vector.bin");
+    }
+
+    std::vector<double> recording;
+};
+
+TEST_F(BinaryStreamingTest, WriterProducesLoadableFile)
+{
+    {
+        BinaryVectorWriter<double> writer("streamed_vector.bin");
+        for (size_t start = 0; start < recording.size(); start += 128)
+        {
+            std::vector<double> chunk(recording.begin() + start,
+                                      recording.begin() + std::min(start + 128, recording.size()));
+            writer.append(chunk);
+        }
+        writer.append(-1.0);
+        EXPECT_EQ(writer.size(), recording.size() + 1);
+    }
+
+    std::vector<double> loaded = loadBinaryVector<double>("streamed_vector.bin");
+    ASSERT_EQ(loaded.size(), recording.size() + 1);
+    EXPECT_TRUE(std::equal(recording.begin(), recording.end(), loaded.begin()));
+    EXPECT_DOUBLE_EQ(loaded.back(), -1.0);
+}
+
+TEST_F(BinaryStreamingTest, ReaderYieldsFixedSizeChunks)
+{
+    saveBinaryVector(recording, "streamed_vector.bin");
+
+    BinaryVectorReader<double> reader("streamed_vector.bin", 300);
+    EXPECT_EQ(reader.size(), recording.size());
+
+    std::vector<size_t> chunk_sizes;
+    std::vector<double> reassembled;
+    while (reader.next())
+    {
+        EXPECT_EQ(reader.chunkOffset(), reassembled.size());
+        chunk_sizes.push_back(reader.chunk().size());
+        reassembled.insert(reassembled.end(), reader.chunk().begin(), reader.chunk().end());
+    }
+
+    EXPECT_EQ(chunk_sizes, (std::vector<size_t>{300, 300, 300, 100}));
+    EXPECT_EQ(reassembled, recording);
+    EXPECT_FALSE(reader.next());
+}
+
+TEST_F(BinaryStreamingTest, ChunkedCheckOnLongRecording)
+{
+    {
+        BinaryVectorWriter<double> writer("streamed_vector.bin");
+        writer.append(recording);
+    }
+
+    BinaryVectorReader<double> reader("streamed_vector.bin", 64);
+    size_t above = 0;
+    while (reader.next())
+    {
+        for (double value : reader.chunk())
+        {
+            above += value > 250.0 ? 1 : 0;
+        }
+    }
+
+    EXPECT_EQ(above, 499u);
+}
+
+TEST_F(BinaryStreamingTest, EmptyAndErrorCases)
+{
+    {
+        BinaryVectorWriter<double> writer("streamed_vector.bin");
+    }
+    EXPECT_TRUE(loadBinaryVector<double>("streamed_vector.bin").empty());
+
+    BinaryVectorReader<double> reader("streamed_vector.bin", 16);
+    EXPECT_FALSE(reader.next());
+
+    EXPECT_THROW(BinaryVectorReader<double>("streamed_vector.bin", 0), std::invalid_argument);
+    EXPECT_THROW(BinaryVectorReader<double>("missing_vector.bin", 16), std::runtime_error);
+    EXPECT_THROW(BinaryVectorReader<float>("streamed_vector.bin", 16), std::runtime_error);
+
+    BinaryVectorWriter<double> writer("streamed_vector.bin");
+    writer.close();
+    EXPECT_THROW(writer.append(1.0), std::runtime_error);
+}
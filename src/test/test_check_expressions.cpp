@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <deque>
+#include <cmath>
+#include "reference_testing/reference_testing.h"
+
+using namespace lumos;
+
+class CheckExpressionsTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        for (size_t i = 0; i < 1000; ++i)
+        {
+            const double t = 0.01 * static_cast<double>(i);
+            x.push_back(0.5 * std::sin(t));
+            x_min.push_back(0.5 * std::sin(t) - 0.1);
+            x_max.push_back(0.5 * std::sin(t) + 0.1);
+        }
+    }
+
+    std::vector<double> x, x_min, x_max;
+};
+
+TEST_F(CheckExpressionsTest, MatchesSeparateCheckers)
+{
+    EXPECT_EQ(isSatisfied(x, all(within(x_min, x_max))), isWithinBounds(x, x_min, x_max));
+    EXPECT_EQ(isSatisfied(x, any(above(0.4))), hasAtLeastNSamplesAboveThreshold(x, 0.4, 1));
+    EXPECT_EQ(isSatisfied(x, runAtLeast(10, below(-0.45))),
+              hasAtLeastNConsecutiveSamplesBelowThreshold(x, -0.45, 10));
+    EXPECT_EQ(isSatisfied(x, countAtLeast(300, above(0.25))), hasAtLeastNSamplesAboveThreshold(x, 0.25, 300));
+    EXPECT_EQ(isSatisfied(x, countAtLeast(400, above(0.25))), hasAtLeastNSamplesAboveThreshold(x, 0.25, 400));
+
+    EXPECT_TRUE(isSatisfied(x, all(within(x_min, x_max)) && any(above(0.4)) && runAtLeast(10, below(-0.45))));
+    EXPECT_FALSE(isSatisfied(x, all(within(x_min, x_max)) && any(above(0.6))));
+    EXPECT_TRUE(isSatisfied(x, any(above(0.6)) || runAtLeast(10, below(-0.45))));
+    EXPECT_FALSE(isSatisfied(x, any(above(0.6)) || !all(within(-0.5, 0.5))));
+    EXPECT_TRUE(isSatisfied(x, !any(above(0.6))));
+}
+
+TEST_F(CheckExpressionsTest, CombinesPredicates)
+{
+    EXPECT_TRUE(isSatisfied(x, all(within(-0.5, 0.5))));
+    EXPECT_TRUE(isSatisfied(x, all(!above(0.5) && !below(-0.5))));
+    EXPECT_FALSE(isSatisfied(x, all(above(0.0) || below(-0.2))));
+    EXPECT_TRUE(isSatisfied(x, runAtLeast(90, above(0.0) && below(0.4))));
+    EXPECT_FALSE(isSatisfied(x, runAtLeast(100, above(0.0) && below(0.4))));
+
+    auto near_zero = [](double v)
+    { return std::abs(v) < 0.01; };
+    EXPECT_EQ(isSatisfied(x, countAtLeast(3, where(near_zero))), hasAtLeastNSamplesWithConditionTrue(x, near_zero, 3));
+    EXPECT_TRUE(isSatisfied(x, any(where(near_zero) && within(x_min, x_max))));
+}
+
+TEST_F(CheckExpressionsTest, EdgeCases)
+{
+    const std::vector<double> empty;
+    EXPECT_TRUE(isSatisfied(empty, all(above(1.0))));
+    EXPECT_FALSE(isSatisfied(empty, any(above(1.0))));
+    EXPECT_TRUE(isSatisfied(empty, runAtLeast(0, above(1.0))));
+
+    // Per-sample bounds of the wrong size fail like isWithinBounds
+    const std::vector<double> short_bounds(10, 0.0);
+    EXPECT_FALSE(isSatisfied(x, all(within(short_bounds, x_max))));
+    EXPECT_FALSE(isSatisfied(x, any(within(x_min, short_bounds)) || any(above(0.0))));
+
+    // Non-contiguous ranges take the element-wise path
+    const std::deque<double> deque_x(x.begin(), x.end());
+    EXPECT_TRUE(isSatisfied(deque_x, all(within(x_min, x_max)) && runAtLeast(10, below(-0.45))));
+
+    const std::vector<float> xf(x.begin(), x.end());
+    EXPECT_TRUE(isSatisfied(xf, all(within(-0.5f, 0.5f)) && any(above(0.4f))));
+}
+
+TEST_F(CheckExpressionsTest, StopsOnceDecided)
+{
+    // Each verdict is decided within the first block, so no predicate may see
+    // more samples than that
+    std::vector<double> values(100000, 1.0);
+    values[5] = -1.0;
+
+    size_t calls = 0;
+    const auto counted_positive = where([&calls](double v) { ++calls; return v > 0.0; });
+    const auto counted_negative = where([&calls](double v) { ++calls; return v < 0.0; });
+
+    EXPECT_FALSE(isSatisfied(values, all(counted_positive)));
+    EXPECT_LE(calls, kExpressionBlockSize);
+
+    calls = 0;
+    EXPECT_TRUE(isSatisfied(values, any(counted_negative) || all(above(5.0))));
+    EXPECT_LE(calls, kExpressionBlockSize);
+
+    calls = 0;
+    EXPECT_FALSE(isSatisfied(values, all(counted_positive) && any(above(5.0))));
+    EXPECT_LE(calls, kExpressionBlockSize);
+}
@@ -0,0 +1,254 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <type_traits>
+#include "reference_testing/reference_testing.h"
+#include "reference_testing/check_plan.h"
+
+using namespace lumos;
+
+class CheckPlanTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        std::vector<double> time_vec, sensor_x, ref_x, x_min, x_max;
+        for (size_t i = 0; i < 200; ++i)
+        {
+            const double t = 0.05 * static_cast<double>(i);
+            time_vec.push_back(t);
+            sensor_x.push_back(std::sin(t) + 0.01 * std::sin(10 * t));
+            ref_x.push_back(std::sin(t));
+            x_min.push_back(std::sin(t) - 0.1);
+            x_max.push_back(std::sin(t) + 0.1);
+        }
+
+        test_signals = std::make_unique<SignalSet<double>>(
+            time_vec, std::vector<std::pair<std::string, std::vector<double>>>{{"x", sensor_x}});
+        reference_signals = std::make_unique<SignalSet<double>>(
+            time_vec, std::vector<std::pair<std::string, std::vector<double>>>{
+                          {"x_ref", ref_x}, {"x_min", x_min}, {"x_max", x_max}});
+    }
+
+    void TearDown() override
+    {
+        std::remove("check_plan.json");
+    }
+
+    std::unique_ptr<SignalSet<double>> test_signals;
+    std::unique_ptr<SignalSet<double>> reference_signals;
+};
+
+TEST_F(CheckPlanTest, MatchesDirectCheckerCalls)
+{
+    const CheckPlan plan = CheckPlan::fromString(R"({
+        "checks": [
+            {"name": "x bounds", "type": "within_bounds", "channel": "x", "min": "x_min", "max": "x_max"},
+            {"name": "x variance", "type": "variance_within_threshold", "channel": "x",
+             "reference": "x_ref", "threshold": 0.001},
+            {"name": "x mean", "type": "mean_difference_within_threshold", "channel": "x",
+             "reference": "x_ref", "threshold": 1e-6},
+            {"name": "x high", "type": "samples_above_threshold", "channel": "x",
+             "threshold": 0.5, "min_samples": 10},
+            {"name": "x low run", "type": "consecutive_samples_below_threshold", "channel": "x",
+             "threshold": -0.5, "min_samples": 500}
+        ]
+    })");
+    ASSERT_EQ(plan.size(), 5u);
+    EXPECT_EQ(plan.checks()[1].kind, PlanCheckKind::VarianceWithinThreshold);
+
+    const BoundCheckPlan<double> bound = plan.bind(*test_signals, *reference_signals);
+    const std::vector<CheckResult<double>> results = bound.evaluate();
+    ASSERT_EQ(results.size(), 5u);
+
+    const SignalSet<double> &test = *test_signals;
+    const SignalSet<double> &reference = *reference_signals;
+    const Span<const double> x = test["x"];
+    const Span<const double> ref = reference["x_ref"];
+    EXPECT_EQ(results[0].name, "x bounds");
+    EXPECT_EQ(results[0].passed, isWithinBounds(x, reference["x_min"], reference["x_max"]));
+    EXPECT_TRUE(results[0].passed);
+    EXPECT_EQ(results[1].passed, isVarianceWithinThreshold(x, ref, 0.001));
+    EXPECT_GT(results[1].value, 0.0);
+    EXPECT_EQ(results[2].passed, isMeanDifferenceWithinThreshold(x, ref, 1e-6));
+    EXPECT_EQ(results[3].passed, hasAtLeastNSamplesAboveThreshold(x, 0.5, 10));
+    EXPECT_TRUE(results[3].passed);
+
+    // Values come from the same kernels as the direct checkers
+    EXPECT_EQ(results[1].value, sumSquaredDifference(x.data(), ref.data(), x.size()) / static_cast<double>(x.size()));
+    EXPECT_EQ(results[2].value, detail::meanDifference(x, ref));
+    EXPECT_EQ(results[3].value, static_cast<double>(countAboveThreshold(x.data(), x.size(), 0.5)));
+    EXPECT_TRUE(isVarianceWithinThreshold(x, ref, results[1].value));
+    EXPECT_FALSE(isVarianceWithinThreshold(x, ref, std::nextafter(results[1].value, 0.0)));
+    EXPECT_TRUE(isMeanDifferenceWithinThreshold(x, ref, results[2].value));
+    EXPECT_FALSE(isMeanDifferenceWithinThreshold(x, ref, std::nextafter(results[2].value, 0.0)));
+    EXPECT_EQ(results[4].passed, hasAtLeastNConsecutiveSamplesBelowThreshold(x, -0.5, 500));
+    EXPECT_FALSE(results[4].passed);
+}
+
+TEST_F(CheckPlanTest, WindowsRestrictTestAndReference)
+{
+    // sin(t) stays above 0.5 for t in [pi/6, 5pi/6] ~ [0.52, 2.62]
+    const CheckPlan plan = CheckPlan::fromString(R"({
+        "checks": [
+            {"name": "inside", "type": "above_threshold_for_duration", "channel": "x",
+             "threshold": 0.5, "min_duration": 1.5, "window": {"start": 0.6, "stop": 2.5}},
+            {"name": "whole", "type": "samples_above_threshold", "channel": "x",
+             "threshold": 0.5, "min_samples": 60},
+            {"name": "window", "type": "samples_above_threshold", "channel": "x",
+             "threshold": 0.5, "min_samples": 10, "window": {"start": 0.575, "stop": 1.025}},
+            {"name": "window count", "type": "samples_above_threshold", "channel": "x",
+             "threshold": 0.5, "min_samples": 9, "window": {"start": 0.575, "stop": 1.025}},
+            {"name": "window variance", "type": "variance_within_threshold", "channel": "x",
+             "reference": "x_ref", "threshold": 0.001, "window": {"start": 0.975, "stop": 1.975}}
+        ]
+    })");
+
+    const std::vector<CheckResult<double>> results = plan.bind(*test_signals, *reference_signals).evaluate();
+    EXPECT_TRUE(results[0].passed);
+    EXPECT_GE(results[0].value, 1.5);
+    EXPECT_TRUE(results[1].passed);
+    // The window holds 9 samples, all above the threshold
+    EXPECT_FALSE(results[2].passed);
+    EXPECT_TRUE(results[3].passed);
+    EXPECT_EQ(results[3].value, 9.0);
+    EXPECT_TRUE(results[4].passed);
+    EXPECT_EQ(results[4].samples_evaluated, 20u);
+}
+
+TEST_F(CheckPlanTest, TimeBasedBoundsUseReferenceTimebase)
+{
+    std::vector<double> coarse_time, coarse_min, coarse_max;
+    for (size_t i = 0; i <= 20; ++i)
+    {
+        coarse_time.push_back(0.5 * static_cast<double>(i));
+        coarse_min.push_back(-2.0);
+        coarse_max.push_back(2.0);
+    }
+    const SignalSet<double> coarse(coarse_time, std::vector<std::pair<std::string, std::vector<double>>>{
+                                                    {"x_min", coarse_min}, {"x_max", coarse_max}});
+
+    const CheckPlan plan = CheckPlan::fromString(R"({"checks": [
+        {"name": "timed", "type": "within_bounds", "channel": "x", "min": "x_min", "max": "x_max", "time_based": true},
+        {"name": "indexed", "type": "within_bounds", "channel": "x", "min": "x_min", "max": "x_max"}
+    ]})");
+
+    const std::vector<CheckResult<double>> results = plan.bind(*test_signals, coarse).evaluate();
+    EXPECT_TRUE(results[0].passed);
+    // Index-aligned bounds of another size fail like the direct checkers do
+    EXPECT_FALSE(results[1].passed);
+    EXPECT_EQ(results[1].samples_evaluated, 0u);
+}
+
+TEST_F(CheckPlanTest, ReusesResultsAcrossRebinding)
+{
+    const CheckPlan plan = CheckPlan::fromString(R"({"checks": [
+        {"name": "x high", "type": "samples_above_threshold", "channel": "x", "threshold": 0.5, "min_samples": 1}
+    ]})");
+
+    std::vector<CheckResult<double>> results;
+    const BoundCheckPlan<double> bound = plan.bind(*test_signals, *reference_signals);
+    bound.evaluate(results);
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_TRUE(results[0].passed);
+
+    // Updating the signals in place is picked up without rebinding
+    for (double &sample : (*test_signals)["x"])
+    {
+        sample = 0.0;
+    }
+    bound.evaluate(results);
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_FALSE(results[0].passed);
+}
+
+TEST_F(CheckPlanTest, LoadsFromFile)
+{
+    std::ofstream("check_plan.json") << R"({"checks": [
+        {"name": "x bounds", "type": "within_bounds", "channel": "x", "min": "x_min", "max": "x_max"}
+    ]})";
+
+    const CheckPlan plan = CheckPlan::load("check_plan.json");
+    ASSERT_EQ(plan.size(), 1u);
+    EXPECT_EQ(plan.checks()[0].min_bounds, "x_min");
+    EXPECT_TRUE(plan.bind(*test_signals, *reference_signals).evaluate()[0].passed);
+
+    EXPECT_THROW(CheckPlan::load("missing_check_plan.json"), std::runtime_error);
+}
+
+TEST_F(CheckPlanTest, RejectsMalformedPlans)
+{
+    EXPECT_THROW(CheckPlan::fromString("{"), std::runtime_error);
+    EXPECT_THROW(CheckPlan::fromString(R"({"tests": []})"), std::runtime_error);
+    EXPECT_THROW(CheckPlan::fromString(R"({"checks": [{"name": "a", "type": "nope", "channel": "x"}]})"),
+                 std::runtime_error);
+    EXPECT_THROW(CheckPlan::fromString(
+                     R"({"checks": [{"name": "a", "type": "samples_above_threshold", "channel": "x", "threshold": 1}]})"),
+                 std::runtime_error);
+    EXPECT_THROW(CheckPlan::fromString(R"({"checks": [{"name": "a", "type": "samples_above_threshold",
+                     "channel": "x", "threshold": "high", "min_samples": 1}]})"),
+                 std::runtime_error);
+    EXPECT_THROW(CheckPlan::fromString(R"({"checks": [{"name": "a", "type": "samples_above_threshold",
+                     "channel": "x", "threshold": 1, "min_samples": -1}]})"),
+                 std::runtime_error);
+    EXPECT_THROW(CheckPlan::fromString(R"({"checks": [{"name": "a", "type": "above_threshold_for_duration",
+                     "channel": "x", "threshold": 1, "min_duration": 1, "window": {"start": 2, "stop": 1}}]})"),
+                 std::runtime_error);
+}
+
+TEST_F(CheckPlanTest, RejectsUnknownKeys)
+{
+    // Misspelled optional keys must not silently fall back to the defaults
+    EXPECT_THROW(CheckPlan::fromString(R"({"checks": [{"name": "a", "type": "within_bounds", "channel": "x",
+                     "min": "x_min", "max": "x_max", "timebased": true}]})"),
+                 std::runtime_error);
+    EXPECT_THROW(CheckPlan::fromString(R"({"checks": [{"name": "a", "type": "samples_above_threshold",
+                     "channel": "x", "threshold": 1, "min_samples": 1, "windows": {"start": 0, "stop": 1}}]})"),
+                 std::runtime_error);
+    EXPECT_THROW(CheckPlan::fromString(R"({"checks": [{"name": "a", "type": "samples_above_threshold",
+                     "channel": "x", "threshold": 1, "min_samples": 1, "window": {"start": 0, "end": 1}}]})"),
+                 std::runtime_error);
+    // Keys valid for another check type are rejected as well
+    EXPECT_THROW(CheckPlan::fromString(R"({"checks": [{"name": "a", "type": "variance_within_threshold",
+                     "channel": "x", "reference": "x_ref", "threshold": 1, "time_based": true}]})"),
+                 std::runtime_error);
+    EXPECT_NO_THROW(CheckPlan::fromString(R"({"checks": [{"name": "a", "type": "within_bounds", "channel": "x",
+                        "min": "x_min", "max": "x_max", "time_based": false, "window": {"start": 0, "stop": 1}}]})"));
+}
+
+namespace
+{
+    template <typename Test, typename Reference, typename = void>
+    struct CanBind : std::false_type
+    {
+    };
+
+    template <typename Test, typename Reference>
+    struct CanBind<Test, Reference,
+                   std::void_t<decltype(std::declval<const CheckPlan &>().bind(std::declval<Test>(),
+                                                                               std::declval<Reference>()))>>
+        : std::true_type
+    {
+    };
+}
+
+TEST_F(CheckPlanTest, BindRejectsTemporarySignalSets)
+{
+    static_assert(CanBind<const SignalSet<double> &, const SignalSet<double> &>::value);
+    static_assert(!CanBind<SignalSet<double>, const SignalSet<double> &>::value);
+    static_assert(!CanBind<const SignalSet<double> &, SignalSet<double>>::value);
+    static_assert(!CanBind<SignalSet<double>, SignalSet<double>>::value);
+}
+
+TEST_F(CheckPlanTest, BindRejectsUnknownChannels)
+{
+    const CheckPlan plan = CheckPlan::fromString(R"({"checks": [
+        {"name": "y mean", "type": "mean_difference_within_threshold", "channel": "x", "reference": "y_ref",
+         "threshold": 0.1}
+    ]})");
+
+    EXPECT_THROW(plan.bind(*test_signals, *reference_signals), std::runtime_error);
+}
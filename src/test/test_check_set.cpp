@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "reference_testing/reference_testing.h"
+
+using namespace lumos;
+
+class CheckSetTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // Longer than one block so checks span several blocks
+        const size_t n = 3 * CheckSet<double>::kBlockSize + 17;
+        for (size_t i = 0; i < n; ++i)
+        {
+            double t = 0.001 * static_cast<double>(i);
+            reference.push_back(std::sin(t));
+            test.push_back(std::sin(t) + 0.01 * std::sin(37.0 * t));
+        }
+        min_bounds.assign(n, -1.5);
+        max_bounds.assign(n, 1.5);
+    }
+
+    std::vector<double> test, reference, min_bounds, max_bounds;
+};
+
+TEST_F(CheckSetTest, MatchesIndividualCheckers)
+{
+    CheckSet<double> checks;
+    checks.addWithinBounds("bounds", min_bounds, max_bounds)
+        .addVarianceWithinThreshold("variance", 0.001)
+        .addMeanDifferenceWithinThreshold("mean", 0.05)
+        .addSamplesAboveThreshold("above", 0.99, 100)
+        .addSamplesBelowThreshold("below", -2.0, 1)
+        .addConsecutiveSamplesAboveThreshold("run above", 0.5, 50)
+        .addConsecutiveSamplesBelowThreshold("run below", -0.5, 50);
+
+    std::vector<CheckResult<double>> results = checks.evaluate(test, reference);
+    ASSERT_EQ(results.size(), checks.size());
+
+    EXPECT_EQ(results[0].name, "bounds");
+    EXPECT_EQ(results[0].passed, isWithinBounds(test, min_bounds, max_bounds));
+    EXPECT_EQ(results[1].passed, isVarianceWithinThreshold(test, reference, 0.001));
+    EXPECT_NEAR(results[1].value, 0.00005, 0.00001);
+    EXPECT_EQ(results[2].passed, isMeanDifferenceWithinThreshold(test, reference, 0.05));
+    EXPECT_EQ(results[3].passed, hasAtLeastNSamplesAboveThreshold(test, 0.99, 100));
+    EXPECT_EQ(results[4].passed, hasAtLeastNSamplesBelowThreshold(test, -2.0, 1));
+    EXPECT_EQ(results[5].passed, hasAtLeastNConsecutiveSamplesAboveThreshold(test, 0.5, 50));
+    EXPECT_EQ(results[6].passed, hasAtLeastNConsecutiveSamplesBelowThreshold(test, -0.5, 50));
+
+    EXPECT_TRUE(results[0].passed);
+    EXPECT_EQ(results[0].samples_evaluated, test.size());
+}
+
+TEST_F(CheckSetTest, DecidedChecksStopEarly)
+{
+    test[10] = 5.0;
+
+    CheckSet<double> checks;
+    checks.addWithinBounds("bounds", min_bounds, max_bounds)
+        .addSamplesAboveThreshold("above", 0.0, 5);
+
+    std::vector<CheckResult<double>> results = checks.evaluate(test, reference);
+
+    EXPECT_FALSE(results[0].passed);
+    EXPECT_EQ(results[0].samples_evaluated, 11u);
+    EXPECT_TRUE(results[1].passed);
+    EXPECT_LT(results[1].samples_evaluated, test.size());
+}
+
+TEST_F(CheckSetTest, SizeMismatch)
+{
+    std::vector<double> short_reference(reference.begin(), reference.begin() + 10);
+    std::vector<double> short_bounds(10, 2.0);
+
+    CheckSet<double> checks;
+    checks.addVarianceWithinThreshold("variance", 1.0)
+        .addWithinBounds("bounds", min_bounds, short_bounds)
+        .addSamplesAboveThreshold("above", 0.5, 1);
+
+    std::vector<CheckResult<double>> results = checks.evaluate(test, short_reference);
+
+    EXPECT_FALSE(results[0].passed);
+    EXPECT_FALSE(results[1].passed);
+    EXPECT_TRUE(results[2].passed);
+}
+
+TEST_F(CheckSetTest, EmptyInput)
+{
+    std::vector<double> empty;
+
+    CheckSet<double> checks;
+    checks.addVarianceWithinThreshold("variance", 0.0)
+        .addWithinBounds("bounds", empty, empty)
+        .addSamplesAboveThreshold("above", 0.5, 1);
+
+    std::vector<CheckResult<double>> results = checks.evaluate(empty, empty);
+
+    EXPECT_TRUE(results[0].passed);
+    EXPECT_TRUE(results[1].passed);
+    EXPECT_FALSE(results[2].passed);
+}
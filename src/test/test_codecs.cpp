@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
+#include "reference_testing/reference_testing.h"
+
+using namespace lumos;
+
+namespace
+{
+    template <typename T>
+    void expectBitIdentical(const std::vector<T> &expected, const std::vector<T> &actual)
+    {
+        ASSERT_EQ(expected.size(), actual.size());
+        EXPECT_EQ(std::memcmp(expected.data(), actual.data(), expected.size() * sizeof(T)), 0);
+    }
+
+    template <typename T>
+    std::vector<T> roundTrip(const std::vector<T> &values, ContainerEncoding encoding)
+    {
+        std::vector<unsigned char> encoded = encodeBlocks(values, encoding);
+        BlockDecoder<T> decoder(encoded.data(), encoded.size(), values.size(), encoding);
+        return decoder.decodeAll();
+    }
+}
+
+TEST(CodecsTest, DeltaOfDeltaRoundTrip)
+{
+    std::vector<double> time;
+    std::vector<int64_t> counter;
+    std::vector<uint16_t> small;
+    for (size_t i = 0; i < 3 * kCodecBlockSize + 17; ++i)
+    {
+        time.push_back(0.01 * static_cast<double>(i));
+        counter.push_back(1000 + 5 * static_cast<int64_t>(i));
+        small.push_back(static_cast<uint16_t>(65500 + i));
+    }
+
+    expectBitIdentical(time, roundTrip(time, ContainerEncoding::DeltaOfDelta));
+    expectBitIdentical(counter, roundTrip(counter, ContainerEncoding::DeltaOfDelta));
+    expectBitIdentical(small, roundTrip(small, ContainerEncoding::DeltaOfDelta));
+
+    // A regular counter has zero second differences and packs to zero bits
+    std::vector<unsigned char> encoded = encodeBlocks(counter, ContainerEncoding::DeltaOfDelta);
+    EXPECT_LT(encoded.size(), counter.size() * sizeof(int64_t) / 50);
+}
+
+TEST(CodecsTest, XorFloatRoundTrip)
+{
+    std::vector<double> sine;
+    std::vector<float> sine_float;
+    for (size_t i = 0; i < 2 * kCodecBlockSize + 1; ++i)
+    {
+        double t = 0.001 * static_cast<double>(i);
+        sine.push_back(std::round(std::sin(t) * 1e4) / 1e4);
+        sine_float.push_back(static_cast<float>(std::sin(t)));
+    }
+
+    expectBitIdentical(sine, roundTrip(sine, ContainerEncoding::XorFloat));
+    expectBitIdentical(sine_float, roundTrip(sine_float, ContainerEncoding::XorFloat));
+
+    std::vector<unsigned char> encoded = encodeBlocks(sine, ContainerEncoding::XorFloat);
+    EXPECT_LT(encoded.size(), sine.size() * sizeof(double));
+}
+
+TEST(CodecsTest, SpecialValuesAndEdgeSizes)
+{
+    std::vector<double> special = {0.0, -0.0, std::numeric_limits<double>::infinity(),
+                                   -std::numeric_limits<double>::infinity(),
+                                   std::numeric_limits<double>::quiet_NaN(),
+                                   std::numeric_limits<double>::denorm_min(),
+                                   std::numeric_limits<double>::max(), 1.0, 1.0, 1.0};
+
+    std::mt19937_64 generator(7);
+    std::vector<double> noise;
+    for (size_t i = 0; i < kCodecBlockSize + 1; ++i)
+    {
+        uint64_t bits = generator();
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        noise.push_back(value);
+    }
+
+    for (ContainerEncoding encoding : {ContainerEncoding::Raw, ContainerEncoding::DeltaOfDelta, ContainerEncoding::XorFloat})
+    {
+        expectBitIdentical(special, roundTrip(special, encoding));
+        expectBitIdentical(noise, roundTrip(noise, encoding));
+        expectBitIdentical(std::vector<double>{42.0}, roundTrip(std::vector<double>{42.0}, encoding));
+        expectBitIdentical(std::vector<double>{1.0, 2.0}, roundTrip(std::vector<double>{1.0, 2.0}, encoding));
+        EXPECT_TRUE(roundTrip(std::vector<double>(), encoding).empty());
+    }
+
+    std::vector<int16_t> shorts = {1, 2, 3};
+    EXPECT_THROW(encodeBlocks(shorts, ContainerEncoding::XorFloat), std::invalid_argument);
+}
+
+TEST(CodecsTest, CorruptStreamThrows)
+{
+    std::vector<double> values(100, 1.5);
+    std::vector<unsigned char> encoded = encodeBlocks(values, ContainerEncoding::XorFloat);
+
+    EXPECT_THROW(BlockDecoder<double>(encoded.data(), 4, values.size(), ContainerEncoding::XorFloat), std::runtime_error);
+    EXPECT_THROW(BlockDecoder<double>(encoded.data(), encoded.size(), 5000, ContainerEncoding::XorFloat), std::runtime_error);
+
+    std::vector<unsigned char> truncated(encoded.begin(), encoded.begin() + 20);
+    truncated[8] = 20;
+    for (size_t i = 9; i < 16; ++i)
+        truncated[i] = 0;
+    BlockDecoder<double> decoder(truncated.data(), truncated.size(), values.size(), ContainerEncoding::XorFloat);
+    std::vector<double> out(kCodecBlockSize);
+    EXPECT_THROW(decoder.decodeBlock(0, out.data()), std::runtime_error);
+    EXPECT_THROW(decoder.decodeBlock(1, out.data()), std::out_of_range);
+}
+
+TEST(CodecsTest, EncodedContainerChannels)
+{
+    std::vector<double> time, x;
+    for (size_t i = 0; i < 10000; ++i)
+    {
+        time.push_back(0.01 * static_cast<double>(i));
+        x.push_back(std::sin(time.back()));
+    }
+
+    {
+        ReferenceContainerWriter writer("codec_reference.lrc");
+        writer.addChannel("time", time, ContainerEncoding::DeltaOfDelta);
+        writer.addChannel("x", x, ContainerEncoding::XorFloat);
+        writer.addChannel("x_raw", x);
+    }
+
+    ReferenceContainer container("codec_reference.lrc");
+    EXPECT_EQ(container.channel("time").encoding, ContainerEncoding::DeltaOfDelta);
+    EXPECT_LT(container.channel("time").payload_size, time.size() * sizeof(double));
+    expectBitIdentical(time, container.load<double>("time"));
+    expectBitIdentical(x, container.load<double>("x"));
+    EXPECT_THROW(container.view<double>("x"), std::runtime_error);
+
+    // Decode block by block into an online checker
+    BlockDecoder<double> decoder = container.decoder<double>("x");
+    Span<const double> raw = container.view<double>("x_raw");
+    OnlineVarianceWithinThreshold<double> variance(0.0, x.size());
+    std::vector<double> block(kCodecBlockSize);
+    for (size_t b = 0; b < decoder.blockCount(); ++b)
+    {
+        size_t count = decoder.decodeBlock(b, block.data());
+        variance.push(Span<const double>(block.data(), count), raw.subspan(b * kCodecBlockSize, count));
+    }
+    EXPECT_EQ(variance.samplesSeen(), x.size());
+    EXPECT_TRUE(variance.verdict());
+
+    std::remove("codec_reference.lrc");
+}
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <cmath>
+#include "reference_testing/reference_testing.h"
+
+using namespace lumos;
+
+class CompiledReferenceTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        for (size_t i = 0; i < 1000; ++i)
+        {
+            double t = 0.01 * static_cast<double>(i);
+            time.push_back(t);
+            reference.push_back(std::sin(t));
+            test.push_back(std::sin(t) + 0.001 * std::cos(7.0 * t));
+            min_bounds.push_back(std::sin(t) - 0.1);
+            max_bounds.push_back(std::sin(t) + 0.1);
+        }
+    }
+
+    std::vector<double> time, reference, test, min_bounds, max_bounds;
+};
+
+TEST_F(CompiledReferenceTest, CachesMeanAndTimeOrder)
+{
+    CompiledReference<double> compiled(time, reference);
+
+    double sum = 0.0;
+    for (double value : reference)
+        sum += value;
+
+    EXPECT_DOUBLE_EQ(compiled.mean(), sum / static_cast<double>(reference.size()));
+    EXPECT_TRUE(compiled.hasTime());
+    EXPECT_TRUE(compiled.isTimeSorted());
+}
+
+TEST_F(CompiledReferenceTest, ViewsCallerDataWithoutCopying)
+{
+    CompiledReference<double> compiled(time, reference);
+    EXPECT_EQ(compiled.data(), reference.data());
+    EXPECT_EQ(compiled.time().data(), time.data());
+
+    // Temporaries are moved in and owned instead of left dangling
+    std::vector<double> moved = reference;
+    const double *moved_data = moved.data();
+    CompiledReference<double> owning(std::move(moved));
+    EXPECT_EQ(owning.data(), moved_data);
+
+    CompiledReference<double> relocated(std::move(owning));
+    EXPECT_EQ(relocated.data(), moved_data);
+    EXPECT_DOUBLE_EQ(relocated.mean(), compiled.mean());
+
+    // Non-contiguous ranges are copied
+    const StridedSpan<const double> every_other(reference.data(), reference.size() / 2, 2 * sizeof(double));
+    CompiledReference<double> strided(every_other);
+    EXPECT_NE(strided.data(), reference.data());
+    EXPECT_EQ(strided[1], reference[2]);
+}
+
+TEST_F(CompiledReferenceTest, MatchesUncompiledCheckers)
+{
+    CompiledReference<double> compiled(reference);
+    CompiledReference<double> compiled_min(time, min_bounds);
+    CompiledReference<double> compiled_max(time, max_bounds);
+
+    for (double threshold : {1e-6, 1e-4, 1e-2})
+    {
+        EXPECT_EQ(isMeanDifferenceWithinThreshold(test, compiled, threshold),
+                  isMeanDifferenceWithinThreshold(test, reference, threshold));
+        EXPECT_EQ(isVarianceWithinThreshold(test, compiled, threshold),
+                  isVarianceWithinThreshold(test, reference, threshold));
+    }
+
+    EXPECT_EQ(isWithinBounds(test, compiled_min, compiled_max),
+              isWithinBounds(test, min_bounds, max_bounds));
+    EXPECT_EQ(isWithinBounds(time, test, compiled_min, compiled_max),
+              isWithinBounds(time, test, time, min_bounds, time, max_bounds));
+
+    test[500] += 1.0;
+    EXPECT_FALSE(isWithinBounds(time, test, compiled_min, compiled_max));
+    EXPECT_FALSE(isWithinBounds(test, compiled_min, compiled_max));
+}
+
+TEST_F(CompiledReferenceTest, BoundsOnDifferentTimebase)
+{
+    // Coarser bound timebase than the test timebase
+    std::vector<double> coarse_time, coarse_min, coarse_max;
+    for (size_t i = 0; i < time.size(); i += 10)
+    {
+        coarse_time.push_back(time[i]);
+        coarse_min.push_back(min_bounds[i]);
+        coarse_max.push_back(max_bounds[i]);
+    }
+
+    CompiledReference<double> compiled_min(coarse_time, coarse_min);
+    CompiledReference<double> compiled_max(coarse_time, coarse_max);
+
+    EXPECT_EQ(isWithinBounds(time, test, compiled_min, compiled_max),
+              isWithinBounds(time, test, coarse_time, coarse_min, coarse_time, coarse_max));
+}
+
+TEST_F(CompiledReferenceTest, InvalidInputs)
+{
+    std::vector<double> short_time(time.begin(), time.begin() + 10);
+    EXPECT_THROW(CompiledReference<double>(short_time, reference), std::invalid_argument);
+
+    CompiledReference<double> no_time(min_bounds);
+    EXPECT_THROW(isWithinBounds(time, test, no_time, no_time), std::invalid_argument);
+
+    CompiledReference<double> compiled(reference);
+    std::vector<double> short_test(test.begin(), test.begin() + 10);
+    EXPECT_FALSE(isMeanDifferenceWithinThreshold(short_test, compiled, 1.0));
+}
+
+TEST(CompiledReferenceFloatTest, WorksWithFloat)
+{
+    std::vector<float> reference = {1.0f, 2.0f, 3.0f, 4.0f};
+    std::vector<float> test = {1.1f, 2.1f, 3.1f, 4.1f};
+    CompiledReference<float> compiled(reference);
+
+    EXPECT_FLOAT_EQ(compiled.mean(), 2.5f);
+    EXPECT_TRUE(isMeanDifferenceWithinThreshold(test, compiled, 0.2f));
+    EXPECT_FALSE(isMeanDifferenceWithinThreshold(test, compiled, 0.05f));
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include "reference_testing/reference_testing.h"
+
+using namespace lumos;
+
+class CorridorTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // U-turn around the origin from -90 to +90 degrees, counter-clockwise,
+        // so the inner arc is the left boundary
+        const size_t n = 181;
+        for (size_t i = 0; i < n; ++i)
+        {
+            double angle = -M_PI / 2.0 + M_PI * static_cast<double>(i) / static_cast<double>(n - 1);
+            x_left.push_back(std::cos(angle));
+            y_left.push_back(std::sin(angle));
+            x_right.push_back(2.0 * std::cos(angle));
+            y_right.push_back(2.0 * std::sin(angle));
+        }
+    }
+
+    // Reference crossing-number test over the closed corridor polygon
+    bool bruteForceContains(double px, double py) const
+    {
+        std::vector<double> xs(x_left), ys(y_left);
+        xs.insert(xs.end(), x_right.rbegin(), x_right.rend());
+        ys.insert(ys.end(), y_right.rbegin(), y_right.rend());
+
+        bool inside = false;
+        for (size_t i = 0, j = xs.size() - 1; i < xs.size(); j = i++)
+        {
+            if ((ys[i] > py) != (ys[j] > py) &&
+                px < (xs[j] - xs[i]) * (py - ys[i]) / (ys[j] - ys[i]) + xs[i])
+            {
+                inside = !inside;
+            }
+        }
+        return inside;
+    }
+
+    std::vector<double> x_left, y_left, x_right, y_right;
+};
+
+TEST_F(CorridorTest, CurvedNonConvexCorridor)
+{
+    Corridor2D<double> corridor(x_left, y_left, x_right, y_right);
+
+    EXPECT_TRUE(corridor.contains(1.5, 0.0));
+    EXPECT_TRUE(corridor.contains(0.05, 1.5));
+    EXPECT_TRUE(corridor.contains(0.05, -1.5));
+    EXPECT_TRUE(corridor.contains(1.5 * std::cos(0.3), 1.5 * std::sin(0.3)));
+
+    EXPECT_FALSE(corridor.contains(0.5, 0.0));  // Inside the inner arc
+    EXPECT_FALSE(corridor.contains(2.5, 0.0));  // Outside the outer arc
+    EXPECT_FALSE(corridor.contains(-1.5, 0.0)); // Other half of the ring
+}
+
+TEST_F(CorridorTest, MatchesBruteForceOnRandomPoints)
+{
+    Corridor2D<double> corridor(x_left, y_left, x_right, y_right);
+
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> coordinate(-2.5, 2.5);
+    for (int i = 0; i < 5000; ++i)
+    {
+        double px = coordinate(rng);
+        double py = coordinate(rng);
+        ASSERT_EQ(corridor.contains(px, py), bruteForceContains(px, py)) << px << ", " << py;
+    }
+}
+
+TEST_F(CorridorTest, ReusedAcrossTrajectories)
+{
+    Corridor2D<double> corridor(x_left, y_left, x_right, y_right);
+
+    std::vector<double> x_inside, y_inside, x_crossing, y_crossing;
+    for (int i = 0; i <= 100; ++i)
+    {
+        double angle = -M_PI / 2.0 + M_PI * i / 100.0;
+        double radius = 1.5 + 0.4 * std::sin(5.0 * angle);
+        x_inside.push_back(radius * std::cos(angle));
+        y_inside.push_back(radius * std::sin(angle));
+        x_crossing.push_back((i == 60 ? 2.2 : 1.5) * std::cos(angle));
+        y_crossing.push_back((i == 60 ? 2.2 : 1.5) * std::sin(angle));
+    }
+
+    EXPECT_TRUE(isWithin2DCorridor(x_inside, y_inside, corridor));
+    EXPECT_FALSE(isWithin2DCorridor(x_crossing, y_crossing, corridor));
+    EXPECT_EQ(corridor.findFirstOutside(x_crossing, y_crossing), 60u);
+
+    // The boundary-vector overload gives the same verdicts
+    EXPECT_TRUE(isWithin2DCorridor(x_inside, y_inside, x_left, y_left, x_right, y_right));
+    EXPECT_FALSE(isWithin2DCorridor(x_crossing, y_crossing, x_left, y_left, x_right, y_right));
+}
+
+TEST_F(CorridorTest, HorizontalCorridorBoundaryPoints)
+{
+    std::vector<double> left_x = {0.0, 5.0, 10.0};
+    std::vector<double> left_y = {1.0, 1.0, 1.0};
+    std::vector<double> right_x = {0.0, 5.0, 10.0};
+    std::vector<double> right_y = {-1.0, -1.0, -1.0};
+    Corridor2D<float> corridor(std::vector<float>(left_x.begin(), left_x.end()),
+                               std::vector<float>(left_y.begin(), left_y.end()),
+                               std::vector<float>(right_x.begin(), right_x.end()),
+                               std::vector<float>(right_y.begin(), right_y.end()));
+
+    EXPECT_TRUE(corridor.contains(5.0f, 0.0f));
+    EXPECT_TRUE(corridor.contains(5.0f, 1.0f));
+    EXPECT_TRUE(corridor.contains(10.0f, 0.5f));
+    EXPECT_FALSE(corridor.contains(10.5f, 0.0f));
+    EXPECT_FALSE(corridor.contains(5.0f, -1.5f));
+}
+
+TEST_F(CorridorTest, ErrorCases)
+{
+    std::vector<double> single_point = {1.0};
+    std::vector<double> short_y = {0.0};
+
+    EXPECT_THROW(Corridor2D<double>(single_point, single_point, x_right, y_right), std::invalid_argument);
+    EXPECT_THROW(Corridor2D<double>(x_left, short_y, x_right, y_right), std::invalid_argument);
+
+    Corridor2D<double> corridor(x_left, y_left, x_right, y_right);
+    std::vector<double> two = {1.0, 2.0};
+    std::vector<double> three = {1.0, 2.0, 3.0};
+    EXPECT_THROW(isWithin2DCorridor(two, three, corridor), std::invalid_argument);
+}
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "reference_testing/reference_testing.h"
+
+using namespace lumos;
+
+TEST(DurationCheckersTest, MatchesSampleCountOnUniformGrid)
+{
+    std::vector<double> time;
+    std::vector<double> values = {0.0, 2.0, 2.0, 2.0, 0.0, 2.0, 2.0, 2.0, 2.0, 2.0, 0.0};
+    for (size_t i = 0; i < values.size(); ++i)
+        time.push_back(0.1 * static_cast<double>(i));
+
+    const TimeRun<double> run = findLongestRunAboveThreshold(time, values, 1.0);
+    EXPECT_DOUBLE_EQ(run.start, 0.5);
+    EXPECT_DOUBLE_EQ(run.end, 1.0);
+    EXPECT_NEAR(run.duration(), 0.5, 1e-12);
+
+    EXPECT_TRUE(isAboveThresholdForAtLeast(time, values, 1.0, 0.45));
+    EXPECT_FALSE(isAboveThresholdForAtLeast(time, values, 1.0, 0.55));
+    EXPECT_EQ(isAboveThresholdForAtLeast(time, values, 1.0, 0.45),
+              hasAtLeastNConsecutiveSamplesAboveThreshold(values, 1.0, 5));
+    EXPECT_TRUE(isBelowThresholdForAtLeast(time, values, 1.0, 0.1));
+    EXPECT_FALSE(isBelowThresholdForAtLeast(time, values, 1.0, 0.15));
+}
+
+TEST(DurationCheckersTest, UsesTimestampsOfIrregularSamples)
+{
+    // Few samples covering a long time beat many samples in a short burst
+    const std::vector<double> time = {0.0, 0.001, 0.002, 0.003, 0.004, 1.0, 3.5, 4.0};
+    const std::vector<double> values = {5.0, 5.0, 5.0, 5.0, 0.0, 5.0, 5.0, 0.0};
+
+    EXPECT_TRUE(isAboveThresholdForAtLeast(time, values, 1.0, 3.0));
+    EXPECT_FALSE(isAboveThresholdForAtLeast(time, values, 1.0, 3.1));
+    // Counting samples favours the burst
+    EXPECT_TRUE(hasAtLeastNConsecutiveSamplesAboveThreshold(values, 1.0, 4));
+    EXPECT_FALSE(hasAtLeastNConsecutiveSamplesAboveThreshold(values, 1.0, 5));
+
+    const TimeRun<double> run = findLongestRunAboveThreshold(time, values, 1.0);
+    EXPECT_DOUBLE_EQ(run.start, 1.0);
+    EXPECT_DOUBLE_EQ(run.end, 4.0);
+
+    auto near_five = [](double v)
+    { return std::abs(v - 5.0) < 0.1; };
+    EXPECT_TRUE(isConditionTrueForAtLeast(time, values, near_five, 3.0));
+}
+
+TEST(DurationCheckersTest, EdgeCases)
+{
+    const std::vector<double> empty;
+    EXPECT_TRUE(std::isnan(findLongestRunAboveThreshold(empty, empty, 0.0).start));
+    EXPECT_EQ(findLongestRunAboveThreshold(empty, empty, 0.0).duration(), 0.0);
+    EXPECT_TRUE(isAboveThresholdForAtLeast(empty, empty, 0.0, 0.0));
+    EXPECT_FALSE(isAboveThresholdForAtLeast(empty, empty, 0.0, 0.1));
+
+    // A run still going at the end lasts until the last sample
+    const std::vector<double> time = {0.0, 1.0, 2.0};
+    const std::vector<double> tail = {0.0, 2.0, 2.0};
+    EXPECT_DOUBLE_EQ(findLongestRunAboveThreshold(time, tail, 1.0).duration(), 1.0);
+
+    // A single sample makes a run of zero length
+    const std::vector<double> single = {0.0, 0.0, 2.0};
+    const TimeRun<double> run = findLongestRunAboveThreshold(time, single, 1.0);
+    EXPECT_DOUBLE_EQ(run.start, 2.0);
+    EXPECT_DOUBLE_EQ(run.duration(), 0.0);
+
+    EXPECT_FALSE(isAboveThresholdForAtLeast(time, std::vector<double>(2, 2.0), 1.0, 0.5));
+    EXPECT_THROW(isAboveThresholdForAtLeast(std::vector<double>{0.0, 2.0, 1.0}, tail, 1.0, 5.0),
+                 std::invalid_argument);
+}
+
+TEST(DurationCheckersTest, OnlineMatchesBatch)
+{
+    std::vector<double> time;
+    std::vector<double> values;
+    double t = 0.0;
+    for (size_t i = 0; i < 5000; ++i)
+    {
+        t += 0.001 + 0.01 * static_cast<double>((i * 7919) % 13) / 13.0;
+        time.push_back(t);
+        values.push_back(std::sin(0.01 * static_cast<double>(i)) + 0.3 * std::sin(0.37 * static_cast<double>(i)));
+    }
+
+    const TimeRun<double> longest = findLongestRunAboveThreshold(time, values, 0.5);
+    ASSERT_GT(longest.duration(), 0.0);
+
+    OnlineDurationAboveThreshold<double> unbounded(0.5, std::numeric_limits<double>::infinity());
+    for (size_t begin = 0; begin < values.size(); begin += 333)
+    {
+        const size_t count = std::min<size_t>(333, values.size() - begin);
+        unbounded.push(Span<const double>(time.data() + begin, count), Span<const double>(values.data() + begin, count));
+    }
+    EXPECT_EQ(unbounded.longestRun().start, longest.start);
+    EXPECT_EQ(unbounded.longestRun().end, longest.end);
+    EXPECT_EQ(unbounded.samplesSeen(), values.size());
+
+    // Decided once a long enough run was seen
+    OnlineDurationAboveThreshold<double> pass(0.5, longest.duration() / 2);
+    pass.push(time, values);
+    EXPECT_TRUE(pass.isDecided());
+    EXPECT_TRUE(pass.verdict());
+    EXPECT_LT(pass.samplesSeen(), values.size());
+
+    // Fails early when the known end time leaves too little room
+    OnlineDurationBelowThreshold<double> fail(-10.0, 1.0, time.back());
+    fail.push(time, values);
+    EXPECT_TRUE(fail.isDecided());
+    EXPECT_FALSE(fail.verdict());
+    EXPECT_LT(fail.samplesSeen(), values.size());
+    EXPECT_FALSE(isBelowThresholdForAtLeast(time, values, -10.0, 1.0));
+
+    auto above = makeOnlineDurationWithConditionTrue<double>([](double v)
+                                                             { return v > 0.5; },
+                                                             longest.duration());
+    above.push(time, values);
+    EXPECT_TRUE(above.verdict());
+}
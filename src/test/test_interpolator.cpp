@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <algorithm>
+#include "reference_testing/reference_testing.h"
+
+using namespace lumos;
+
+class InterpolatorTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        time_vec = {0.0, 1.0, 1.0, 2.0, 3.0, 4.0};
+        value_vec = {0.0, 10.0, 12.0, 5.0, 15.0, 20.0};
+    }
+
+    std::vector<double> time_vec;
+    std::vector<double> value_vec;
+};
+
+TEST_F(InterpolatorTest, SortedQueriesMatchInterpolateAtTime)
+{
+    Interpolator<double> interpolator(time_vec, value_vec);
+
+    for (double t = -1.0; t <= 5.0; t += 0.125)
+    {
+        EXPECT_EQ(interpolator(t), interpolateAtTime(t, time_vec, value_vec)) << "t = " << t;
+    }
+}
+
+TEST_F(InterpolatorTest, UnsortedQueriesMatchInterpolateAtTime)
+{
+    Interpolator<double> interpolator(time_vec, value_vec);
+    std::vector<double> query_times = {3.5, 0.5, 1.0, 4.5, 2.0, -0.5, 2.5, 1.0, 0.25};
+
+    for (double t : query_times)
+    {
+        EXPECT_EQ(interpolator(t), interpolateAtTime(t, time_vec, value_vec)) << "t = " << t;
+    }
+}
+
+TEST_F(InterpolatorTest, RandomQueriesMatchInterpolateAtTime)
+{
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> step(0.0, 0.1);
+    std::uniform_real_distribution<double> value(-1.0, 1.0);
+
+    std::vector<double> ref_time(500), ref_value(500);
+    double t = 0.0;
+    for (size_t i = 0; i < ref_time.size(); ++i)
+    {
+        t += step(rng);
+        ref_time[i] = t;
+        ref_value[i] = value(rng);
+    }
+
+    std::uniform_real_distribution<double> query(-1.0, t + 1.0);
+    std::vector<double> query_times(2000);
+    for (double &q : query_times)
+    {
+        q = query(rng);
+    }
+
+    Interpolator<double> unsorted_interpolator(ref_time, ref_value);
+    for (double q : query_times)
+    {
+        ASSERT_EQ(unsorted_interpolator(q), interpolateAtTime(q, ref_time, ref_value));
+    }
+
+    std::sort(query_times.begin(), query_times.end());
+    Interpolator<double> sorted_interpolator(ref_time, ref_value);
+    for (double q : query_times)
+    {
+        ASSERT_EQ(sorted_interpolator(q), interpolateAtTime(q, ref_time, ref_value));
+    }
+}
+
+TEST_F(InterpolatorTest, ErrorCases)
+{
+    std::vector<double> empty_time, empty_value;
+    std::vector<double> mismatched_time = {1.0, 2.0};
+    std::vector<double> mismatched_value = {1.0, 2.0, 3.0};
+
+    EXPECT_THROW(Interpolator<double>(empty_time, empty_value), std::invalid_argument);
+    EXPECT_THROW(Interpolator<double>(mismatched_time, mismatched_value), std::invalid_argument);
+}
+
+TEST_F(InterpolatorTest, TimeBasedBoundsWithUnsortedTestTimes)
+{
+    std::vector<double> bounds_time = {0.0, 2.0, 4.0};
+    std::vector<double> min_bounds = {-0.3, -0.2, -0.1};
+    std::vector<double> max_bounds = {0.3, 0.2, 0.1};
+
+    std::vector<double> test_time = {3.5, 0.5, 4.5, 1.0};
+    std::vector<double> passing = {0.1, 0.25, 0.05, -0.2};
+    std::vector<double> failing = {0.2, 0.25, 0.05, -0.2};
+
+    EXPECT_TRUE(isWithinBounds(test_time, passing, bounds_time, min_bounds, bounds_time, max_bounds));
+    EXPECT_FALSE(isWithinBounds(test_time, failing, bounds_time, min_bounds, bounds_time, max_bounds));
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include "reference_testing/reference_testing.h"
+
+using namespace lumos;
+
+class MappedVectorTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        reference = {1.0, 2.0, 3.0, 4.0, 5.0};
+        saveBinaryVector(reference, "mapped_reference.bin");
+    }
+
+    void TearDown() override
+    {
+        std::remove("mapped_reference.bin");
+        std::remove("mapped_bounds_min.bin");
+        std::remove("mapped_bounds_max.bin");
+        std::remove("mapped_legacy.bin");
+    }
+
+    std::vector<double> reference;
+};
+
+TEST_F(MappedVectorTest, MapsSavedVector)
+{
+    MappedVector<double> mapped("mapped_reference.bin");
+
+    ASSERT_EQ(mapped.size(), reference.size());
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(mapped.data()) % alignof(double), 0u);
+    for (size_t i = 0; i < reference.size(); ++i)
+    {
+        EXPECT_DOUBLE_EQ(mapped[i], reference[i]);
+    }
+    EXPECT_EQ(mapped.toVector(), reference);
+}
+
+TEST_F(MappedVectorTest, CheckersRunOnMappedData)
+{
+    std::vector<double> min_bounds = {0.5, 1.5, 2.5, 3.5, 4.5};
+    std::vector<double> max_bounds = {1.5, 2.5, 3.5, 4.5, 5.5};
+    saveBinaryVector(min_bounds, "mapped_bounds_min.bin");
+    saveBinaryVector(max_bounds, "mapped_bounds_max.bin");
+
+    MappedVector<double> mapped_reference("mapped_reference.bin");
+    MappedVector<double> mapped_min("mapped_bounds_min.bin");
+    MappedVector<double> mapped_max("mapped_bounds_max.bin");
+
+    std::vector<double> test_vec = {1.01, 1.99, 3.02, 3.98, 5.01};
+
+    EXPECT_TRUE(isWithinBounds(test_vec, mapped_min, mapped_max));
+    EXPECT_TRUE(isVarianceWithinThreshold(test_vec, mapped_reference, 0.01));
+    EXPECT_TRUE(isMeanDifferenceWithinThreshold(test_vec, mapped_reference, 0.1));
+    EXPECT_TRUE(hasAtLeastNSamplesAboveThreshold(mapped_reference, 2.5, 3));
+    EXPECT_TRUE(isWithinBounds(test_vec, test_vec, mapped_reference, mapped_min, mapped_reference, mapped_max));
+}
+
+TEST_F(MappedVectorTest, LegacyUnalignedFile)
+{
+    // Layout written before payloads were padded to an aligned offset
+    std::ofstream file("mapped_legacy.bin", std::ios::binary);
+    const char *type_name = typeid(double).name();
+    size_t type_name_length = std::strlen(type_name);
+    size_t element_size = sizeof(double);
+    size_t vector_size = reference.size();
+    file.write(reinterpret_cast<const char *>(&type_name_length), sizeof(type_name_length));
+    file.write(type_name, type_name_length);
+    file.write(reinterpret_cast<const char *>(&element_size), sizeof(element_size));
+    file.write(reinterpret_cast<const char *>(&vector_size), sizeof(vector_size));
+    file.write(reinterpret_cast<const char *>(reference.data()), vector_size * sizeof(double));
+    file.close();
+
+    MappedVector<double> mapped("mapped_legacy.bin");
+    EXPECT_EQ(mapped.toVector(), reference);
+    EXPECT_EQ(loadBinaryVector<double>("mapped_legacy.bin"), reference);
+}
+
+TEST_F(MappedVectorTest, RejectsCorruptElementCount)
+{
+    auto write_legacy = [&](size_t vector_size)
+    {
+        std::ofstream file("mapped_legacy.bin", std::ios::binary);
+        const char *type_name = typeid(double).name();
+        size_t type_name_length = std::strlen(type_name);
+        size_t element_size = sizeof(double);
+        file.write(reinterpret_cast<const char *>(&type_name_length), sizeof(type_name_length));
+        file.write(type_name, type_name_length);
+        file.write(reinterpret_cast<const char *>(&element_size), sizeof(element_size));
+        file.write(reinterpret_cast<const char *>(&vector_size), sizeof(vector_size));
+        file.write(reinterpret_cast<const char *>(reference.data()), reference.size() * sizeof(double));
+    };
+
+    // One element more than the payload holds
+    write_legacy(reference.size() + 1);
+    EXPECT_THROW(MappedVector<double>("mapped_legacy.bin"), std::runtime_error);
+
+    // A count whose byte size wraps around to the payload size
+    write_legacy((size_t(1) << 61) + reference.size());
+    EXPECT_THROW(MappedVector<double>("mapped_legacy.bin"), std::runtime_error);
+}
+
+TEST_F(MappedVectorTest, MoveKeepsData)
+{
+    MappedVector<double> mapped("mapped_reference.bin");
+    MappedVector<double> moved(std::move(mapped));
+
+    EXPECT_EQ(moved.toVector(), reference);
+    EXPECT_EQ(mapped.size(), 0u);
+}
+
+TEST_F(MappedVectorTest, ErrorCases)
+{
+    EXPECT_THROW(MappedVector<double>("missing_reference.bin"), std::runtime_error);
+    EXPECT_THROW(MappedVector<float>("mapped_reference.bin"), std::runtime_error);
+}
@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "reference_testing/reference_testing.h"
+
+using namespace lumos;
+
+class OnlineCheckersTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        std::mt19937 rng(3);
+        std::normal_distribution<double> noise(0.0, 0.1);
+        for (int i = 0; i < 500; ++i)
+        {
+            double ref = std::sin(0.02 * i);
+            reference.push_back(ref);
+            test.push_back(ref + noise(rng));
+            min_bounds.push_back(ref - 0.5);
+            max_bounds.push_back(ref + 0.5);
+        }
+    }
+
+    std::vector<double> test, reference, min_bounds, max_bounds;
+};
+
+TEST_F(OnlineCheckersTest, MatchesBatchCheckers)
+{
+    OnlineWithinBounds<double> bounds;
+    OnlineVarianceWithinThreshold<double> variance(0.011);
+    OnlineMeanDifferenceWithinThreshold<double> mean_difference(0.01);
+    OnlineSamplesAboveThreshold<double> above(0.9, 60);
+    OnlineConsecutiveSamplesBelowThreshold<double> below(-0.9, 20);
+
+    for (size_t i = 0; i < test.size(); ++i)
+    {
+        bounds.push(test[i], min_bounds[i], max_bounds[i]);
+        variance.push(test[i], reference[i]);
+        mean_difference.push(test[i], reference[i]);
+        above.push(test[i]);
+        below.push(test[i]);
+    }
+
+    EXPECT_EQ(bounds.verdict(), isWithinBounds(test, min_bounds, max_bounds));
+    EXPECT_EQ(variance.verdict(), isVarianceWithinThreshold(test, reference, 0.011));
+    EXPECT_EQ(mean_difference.verdict(), isMeanDifferenceWithinThreshold(test, reference, 0.01));
+    EXPECT_EQ(above.verdict(), hasAtLeastNSamplesAboveThreshold(test, 0.9, 60));
+    EXPECT_EQ(below.verdict(), hasAtLeastNConsecutiveSamplesBelowThreshold(test, -0.9, 20));
+}
+
+TEST_F(OnlineCheckersTest, ChunkedPushMatchesSamplePush)
+{
+    OnlineVarianceWithinThreshold<double> by_sample(0.02);
+    OnlineVarianceWithinThreshold<double> by_chunk(0.02);
+
+    for (size_t i = 0; i < test.size(); ++i)
+    {
+        by_sample.push(test[i], reference[i]);
+    }
+
+    for (size_t start = 0; start < test.size(); start += 100)
+    {
+        std::vector<double> test_chunk(test.begin() + start, test.begin() + start + 100);
+        std::vector<double> reference_chunk(reference.begin() + start, reference.begin() + start + 100);
+        by_chunk.push(test_chunk, reference_chunk);
+    }
+
+    EXPECT_EQ(by_sample.variance(), by_chunk.variance());
+    EXPECT_EQ(by_sample.verdict(), by_chunk.verdict());
+    EXPECT_NEAR(by_chunk.variance(), 0.01, 0.002);
+}
+
+TEST_F(OnlineCheckersTest, BoundsViolationDecidesImmediately)
+{
+    OnlineWithinBounds<double> bounds;
+    bounds.push(0.0, -1.0, 1.0);
+    EXPECT_FALSE(bounds.isDecided());
+
+    bounds.push(2.0, -1.0, 1.0);
+    EXPECT_TRUE(bounds.isDecided());
+    EXPECT_FALSE(bounds.verdict());
+
+    bounds.push(0.0, -1.0, 1.0);
+    EXPECT_EQ(bounds.samplesSeen(), 2u);
+}
+
+TEST_F(OnlineCheckersTest, VarianceFailsEarlyWithExpectedLength)
+{
+    OnlineVarianceWithinThreshold<double> variance(0.01, 100);
+
+    variance.push(0.0, 0.0);
+    EXPECT_FALSE(variance.isDecided());
+
+    // A single squared difference of 4 over 100 samples already exceeds 0.01
+    variance.push(2.0, 0.0);
+    EXPECT_TRUE(variance.isDecided());
+    EXPECT_FALSE(variance.verdict());
+}
+
+TEST_F(OnlineCheckersTest, VarianceKeepsGoingPastUnderestimatedLength)
+{
+    const std::vector<double> test_values = {0.0, 0.0, 1.0, 10.0};
+    const std::vector<double> reference_values(test_values.size(), 0.0);
+
+    OnlineVarianceWithinThreshold<double> variance(0.5, 1);
+    variance.push(test_values, reference_values);
+
+    EXPECT_EQ(variance.samplesSeen(), test_values.size());
+    EXPECT_FALSE(variance.verdict());
+    EXPECT_EQ(variance.verdict(), isVarianceWithinThreshold(test_values, reference_values, 0.5));
+}
+
+TEST_F(OnlineCheckersTest, CountersDecideEarly)
+{
+    OnlineSamplesAboveThreshold<double> above(1.0, 2);
+    above.push(std::vector<double>{0.5, 1.5, 2.5, 3.5});
+    EXPECT_TRUE(above.isDecided());
+    EXPECT_TRUE(above.verdict());
+    EXPECT_EQ(above.samplesSeen(), 3u);
+
+    OnlineSamplesBelowThreshold<double> below(0.0, 3, 4);
+    below.push(1.0);
+    EXPECT_FALSE(below.isDecided());
+    below.push(1.0);
+    EXPECT_TRUE(below.isDecided());
+    EXPECT_FALSE(below.verdict());
+
+    OnlineConsecutiveSamplesAboveThreshold<double> run(1.0, 3, 6);
+    run.push(std::vector<double>{2.0, 2.0, 0.0});
+    EXPECT_FALSE(run.isDecided());
+    run.push(0.0);
+    EXPECT_TRUE(run.isDecided());
+    EXPECT_FALSE(run.verdict());
+    EXPECT_EQ(run.longestRun(), 2u);
+}
+
+TEST_F(OnlineCheckersTest, CustomConditions)
+{
+    auto is_positive = [](double x)
+    { return x > 0; };
+
+    auto count = makeOnlineSamplesWithConditionTrue<double>(is_positive, 4);
+    auto consecutive = makeOnlineConsecutiveSamplesWithConditionTrue<double>(is_positive, 3);
+
+    std::vector<double> values = {-1.5, 2.5, -0.5, 3.5, 1.5, -2.5, 4.5};
+    count.push(values);
+    consecutive.push(values);
+
+    EXPECT_TRUE(count.verdict());
+    EXPECT_FALSE(consecutive.verdict());
+    EXPECT_EQ(consecutive.longestRun(), 2u);
+}
+
+TEST_F(OnlineCheckersTest, EmptyAndMismatchedInput)
+{
+    OnlineVarianceWithinThreshold<double> variance(0.0);
+    OnlineMeanDifferenceWithinThreshold<double> mean_difference(0.0);
+    OnlineConsecutiveSamplesAboveThreshold<double> run(1.0, 0);
+
+    EXPECT_TRUE(variance.verdict());
+    EXPECT_TRUE(mean_difference.verdict());
+    EXPECT_TRUE(run.verdict());
+
+    std::vector<double> short_vec = {1.0};
+    std::vector<double> long_vec = {1.0, 2.0};
+    variance.push(short_vec, long_vec);
+    mean_difference.push(short_vec, long_vec);
+
+    EXPECT_TRUE(variance.isDecided());
+    EXPECT_FALSE(variance.verdict());
+    EXPECT_FALSE(mean_difference.verdict());
+}
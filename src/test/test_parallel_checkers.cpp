@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <cmath>
+#include <random>
+#include "reference_testing/reference_testing.h"
+
+using namespace lumos;
+
+class ParallelCheckersTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // A little over three chunks so every reduction has a ragged tail
+        const size_t n = 3 * kParallelChunkSize + 12345;
+        std::mt19937 generator(42);
+        std::normal_distribution<double> noise(0.0, 0.1);
+        for (size_t i = 0; i < n; ++i)
+        {
+            double t = 1e-4 * static_cast<double>(i);
+            reference.push_back(std::sin(t));
+            test.push_back(std::sin(t) + noise(generator));
+            min_bounds.push_back(std::sin(t) - 1.0);
+            max_bounds.push_back(std::sin(t) + 1.0);
+        }
+    }
+
+    std::vector<double> reference, test, min_bounds, max_bounds;
+};
+
+TEST_F(ParallelCheckersTest, BoundsMatchSerial)
+{
+    ThreadPool pool(4);
+    EXPECT_EQ(findFirstOutsideBoundsParallel(pool, test, min_bounds, max_bounds), test.size());
+    EXPECT_TRUE(isWithinBoundsParallel(pool, test, min_bounds, max_bounds));
+
+    // The earliest violation wins even when a later chunk finds one first
+    test[3 * kParallelChunkSize + 10] += 5.0;
+    test[kParallelChunkSize + 7] -= 5.0;
+    EXPECT_EQ(findFirstOutsideBoundsParallel(pool, test, min_bounds, max_bounds), kParallelChunkSize + 7);
+    EXPECT_FALSE(isWithinBoundsParallel(pool, test, min_bounds, max_bounds));
+    EXPECT_EQ(isWithinBoundsParallel(pool, test, min_bounds, max_bounds), isWithinBounds(test, min_bounds, max_bounds));
+
+    std::vector<double> short_bounds(10, 0.0);
+    EXPECT_FALSE(isWithinBoundsParallel(pool, test, short_bounds, short_bounds));
+}
+
+TEST_F(ParallelCheckersTest, VarianceIsIndependentOfThreadCount)
+{
+    // Variance as reduced by the fixed chunking
+    double sum = 0.0;
+    for (size_t start = 0; start < test.size(); start += kParallelChunkSize)
+    {
+        sum += sumSquaredDifference(test.data() + start, reference.data() + start,
+                                    std::min(kParallelChunkSize, test.size() - start));
+    }
+    const double variance = sum / static_cast<double>(test.size());
+    const double just_below = std::nextafter(variance, 0.0);
+
+    for (size_t threads : {1u, 2u, 3u, 8u})
+    {
+        ThreadPool pool(threads);
+        EXPECT_TRUE(isVarianceWithinThresholdParallel(pool, test, reference, variance)) << threads;
+        EXPECT_FALSE(isVarianceWithinThresholdParallel(pool, test, reference, just_below)) << threads;
+        EXPECT_EQ(isMeanDifferenceWithinThresholdParallel(pool, test, reference, 1e-3),
+                  isMeanDifferenceWithinThreshold(test, reference, 1e-3));
+    }
+}
+
+TEST_F(ParallelCheckersTest, ShortChannelMatchesSerialExactly)
+{
+    ThreadPool pool(4);
+    std::vector<double> short_test(test.begin(), test.begin() + 1000);
+    std::vector<double> short_reference(reference.begin(), reference.begin() + 1000);
+
+    double variance = sumSquaredDifference(short_test.data(), short_reference.data(), 1000) / 1000.0;
+    EXPECT_TRUE(isVarianceWithinThresholdParallel(pool, short_test, short_reference, variance));
+    EXPECT_EQ(isVarianceWithinThresholdParallel(pool, short_test, short_reference, std::nextafter(variance, 0.0)),
+              isVarianceWithinThreshold(short_test, short_reference, std::nextafter(variance, 0.0)));
+}
+
+TEST_F(ParallelCheckersTest, CountsMatchSerial)
+{
+    ThreadPool pool(4);
+    size_t above = 0, below = 0;
+    for (double value : test)
+    {
+        above += value > 0.9 ? 1 : 0;
+        below += value < -0.9 ? 1 : 0;
+    }
+
+    EXPECT_TRUE(hasAtLeastNSamplesAboveThresholdParallel(pool, test, 0.9, above));
+    EXPECT_FALSE(hasAtLeastNSamplesAboveThresholdParallel(pool, test, 0.9, above + 1));
+    EXPECT_TRUE(hasAtLeastNSamplesBelowThresholdParallel(pool, test, -0.9, below));
+    EXPECT_FALSE(hasAtLeastNSamplesBelowThresholdParallel(pool, test, -0.9, below + 1));
+    EXPECT_TRUE(hasAtLeastNSamplesAboveThresholdParallel(pool, test, 0.9, 0));
+}
+
+TEST(ParallelConsecutiveTest, RunsAcrossChunkBoundaries)
+{
+    ThreadPool pool(4);
+    std::vector<float> values(4 * kParallelChunkSize, 0.0f);
+
+    // A run of 30 straddling the first boundary and one spanning a whole
+    // chunk plus both neighbours' edges
+    for (size_t i = kParallelChunkSize - 10; i < kParallelChunkSize + 20; ++i)
+        values[i] = 1.0f;
+    for (size_t i = 2 * kParallelChunkSize - 5; i < 3 * kParallelChunkSize + 5; ++i)
+        values[i] = 1.0f;
+
+    const size_t long_run = kParallelChunkSize + 10;
+    EXPECT_TRUE(hasAtLeastNConsecutiveSamplesAboveThresholdParallel(pool, values, 0.5f, 30));
+    EXPECT_TRUE(hasAtLeastNConsecutiveSamplesAboveThresholdParallel(pool, values, 0.5f, long_run));
+    EXPECT_FALSE(hasAtLeastNConsecutiveSamplesAboveThresholdParallel(pool, values, 0.5f, long_run + 1));
+    EXPECT_EQ(hasAtLeastNConsecutiveSamplesAboveThresholdParallel(pool, values, 0.5f, long_run + 1),
+              hasAtLeastNConsecutiveSamplesAboveThreshold(values, 0.5f, long_run + 1));
+
+    EXPECT_TRUE(hasAtLeastNConsecutiveSamplesBelowThresholdParallel(pool, values, 0.5f, kParallelChunkSize - 10));
+    EXPECT_FALSE(hasAtLeastNConsecutiveSamplesBelowThresholdParallel(pool, values, 0.5f, kParallelChunkSize));
+    EXPECT_TRUE(hasAtLeastNConsecutiveSamplesBelowThresholdParallel(pool, values, 0.5f, 0));
+
+    std::vector<float> empty;
+    EXPECT_FALSE(hasAtLeastNConsecutiveSamplesAboveThresholdParallel(pool, empty, 0.5f, 1));
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include "reference_testing/reference_testing.h"
+
+using namespace lumos;
+
+template <typename Q>
+class QuantizedBoundsTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        std::mt19937 generator(3);
+        std::uniform_real_distribution<double> jitter(-0.2, 0.2);
+        for (size_t i = 0; i < 5000; ++i)
+        {
+            double t = 0.01 * static_cast<double>(i);
+            double center = 10.0 * std::sin(t);
+            min_bounds.push_back(center - 0.5 + jitter(generator));
+            max_bounds.push_back(center + 0.5 + jitter(generator));
+            test.push_back(center);
+        }
+    }
+
+    std::vector<double> min_bounds, max_bounds, test;
+};
+
+using StorageTypes = ::testing::Types<uint8_t, uint16_t>;
+TYPED_TEST_SUITE(QuantizedBoundsTest, StorageTypes);
+
+TYPED_TEST(QuantizedBoundsTest, RoundsConservatively)
+{
+    QuantizedBounds<double, TypeParam> bounds(this->min_bounds, this->max_bounds);
+
+    ASSERT_EQ(bounds.size(), this->min_bounds.size());
+    double widening = 0.0;
+    for (size_t i = 0; i < bounds.size(); ++i)
+    {
+        ASSERT_LE(bounds.minAt(i), this->min_bounds[i]) << i;
+        ASSERT_GE(bounds.maxAt(i), this->max_bounds[i]) << i;
+        widening = std::max({widening, this->min_bounds[i] - bounds.minAt(i), bounds.maxAt(i) - this->max_bounds[i]});
+    }
+    EXPECT_EQ(widening, bounds.maxWidening());
+
+    // Widening stays below one step of the coarsest block
+    const std::vector<double> &steps = bounds.blockSteps();
+    EXPECT_LE(bounds.maxWidening(), *std::max_element(steps.begin(), steps.end()));
+}
+
+TYPED_TEST(QuantizedBoundsTest, PassStaysPass)
+{
+    QuantizedBounds<double, TypeParam> bounds(this->min_bounds, this->max_bounds);
+
+    // Tests sitting exactly on the original bounds still pass
+    EXPECT_TRUE(isWithinBounds(this->min_bounds, bounds));
+    EXPECT_TRUE(isWithinBounds(this->max_bounds, bounds));
+    EXPECT_TRUE(isWithinBounds(this->test, bounds));
+
+    this->test[4321] = this->max_bounds[4321] + 1.0;
+    EXPECT_FALSE(isWithinBounds(this->test, bounds));
+    EXPECT_EQ(bounds.findFirstOutside(this->test.data(), this->test.size()), 4321u);
+
+    std::vector<double> short_test(10, 0.0);
+    EXPECT_FALSE(isWithinBounds(short_test, bounds));
+}
+
+TYPED_TEST(QuantizedBoundsTest, StoredInContainer)
+{
+    QuantizedBounds<double, TypeParam> bounds(this->min_bounds, this->max_bounds);
+    {
+        ReferenceContainerWriter writer("quantized_bounds.lrc");
+        addQuantizedBounds(writer, "x", bounds);
+    }
+
+    ReferenceContainer container("quantized_bounds.lrc");
+    QuantizedBounds<double, TypeParam> loaded = loadQuantizedBounds<double, TypeParam>(container, "x");
+    for (size_t i = 0; i < bounds.size(); ++i)
+    {
+        ASSERT_EQ(loaded.minAt(i), bounds.minAt(i));
+        ASSERT_EQ(loaded.maxAt(i), bounds.maxAt(i));
+    }
+    EXPECT_TRUE(isWithinBounds(this->test, loaded));
+
+    std::remove("quantized_bounds.lrc");
+}
+
+TEST(QuantizedBoundsEdgeTest, ToleranceAndInvalidInput)
+{
+    std::vector<float> min_bounds = {0.0f, -100.0f, 0.0f};
+    std::vector<float> max_bounds = {1.0f, 100.0f, 1.0f};
+
+    EXPECT_THROW((QuantizedBounds<float, uint8_t>(min_bounds, max_bounds, 0.1f)), std::invalid_argument);
+    EXPECT_NO_THROW((QuantizedBounds<float, uint16_t>(min_bounds, max_bounds, 0.01f)));
+
+    std::vector<float> short_bounds = {0.0f};
+    EXPECT_THROW((QuantizedBounds<float, uint8_t>(short_bounds, max_bounds)), std::invalid_argument);
+
+    std::vector<float> infinite = {0.0f, INFINITY, 1.0f};
+    EXPECT_THROW((QuantizedBounds<float, uint8_t>(min_bounds, infinite)), std::invalid_argument);
+
+    // Constant bounds decode exactly
+    std::vector<float> constant(600, 2.5f);
+    QuantizedBounds<float, uint8_t> flat(constant, constant);
+    EXPECT_EQ(flat.maxWidening(), 0.0f);
+    EXPECT_TRUE(isWithinBounds(constant, flat));
+
+    const std::vector<float> no_bounds;
+    QuantizedBounds<float, uint8_t> empty(no_bounds, no_bounds);
+    EXPECT_TRUE(isWithinBounds(std::vector<float>(), empty));
+}
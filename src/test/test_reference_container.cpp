@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include "reference_testing/reference_testing.h"
+
+using namespace lumos;
+
+class ReferenceContainerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        for (size_t i = 0; i < 1000; ++i)
+        {
+            time.push_back(0.01 * static_cast<double>(i));
+            x.push_back(static_cast<double>(i) * 0.5);
+        }
+        y = {1.0f, 2.0f, 3.0f};
+        flags = {1, -2, 3, -4, 5};
+
+        ReferenceContainerWriter writer("container_reference.lrc");
+        writer.addChannel("time", time);
+        writer.addChannel("x", x);
+        writer.addChannel("y", y);
+        writer.addChannel("flags", flags);
+        writer.addChannel("empty", std::vector<double>());
+        writer.close();
+    }
+
+    void TearDown() override
+    {
+        std::remove("container_reference.lrc");
+        std::remove("container_swapped.lrc");
+        std::remove("container_invalid.lrc");
+    }
+
+    std::vector<double> time, x;
+    std::vector<float> y;
+    std::vector<int32_t> flags;
+};
+
+TEST_F(ReferenceContainerTest, ReadsAllChannels)
+{
+    ReferenceContainer container("container_reference.lrc");
+
+    ASSERT_EQ(container.size(), 5u);
+    EXPECT_FALSE(container.isByteSwapped());
+    EXPECT_TRUE(container.hasChannel("x"));
+    EXPECT_FALSE(container.hasChannel("z"));
+    EXPECT_EQ(container.channels()[1].name, "x");
+    EXPECT_EQ(container.channel("y").type, ContainerTypeTag::Float32);
+    EXPECT_EQ(container.channel("x").element_count, x.size());
+
+    EXPECT_EQ(container.load<double>("time"), time);
+    EXPECT_EQ(container.load<double>("x"), x);
+    EXPECT_EQ(container.load<float>("y"), y);
+    EXPECT_EQ(container.load<int32_t>("flags"), flags);
+    EXPECT_TRUE(container.load<double>("empty").empty());
+}
+
+TEST_F(ReferenceContainerTest, ViewsAreAlignedAndZeroCopy)
+{
+    ReferenceContainer container("container_reference.lrc");
+
+    for (const ContainerChannel &channel : container.channels())
+    {
+        EXPECT_EQ(channel.payload_offset % kBinaryPayloadAlignment, 0u) << channel.name;
+    }
+
+    Span<const double> view = container.view<double>("x");
+    ASSERT_EQ(view.size(), x.size());
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(view.data()) % kBinaryPayloadAlignment, 0u);
+    for (size_t i = 0; i < x.size(); ++i)
+    {
+        EXPECT_EQ(view[i], x[i]);
+    }
+
+    // Views feed the checkers directly
+    std::vector<double> test_vec(x);
+    EXPECT_TRUE(isVarianceWithinThreshold(test_vec, view, 0.0));
+    EXPECT_TRUE(isWithinBounds(test_vec, view, view));
+}
+
+TEST_F(ReferenceContainerTest, Errors)
+{
+    ReferenceContainer container("container_reference.lrc");
+    EXPECT_THROW(container.load<double>("missing"), std::runtime_error);
+    EXPECT_THROW(container.load<float>("x"), std::runtime_error);
+    EXPECT_THROW(container.view<double>("y"), std::runtime_error);
+
+    EXPECT_THROW(ReferenceContainer("no_such_container.lrc"), std::runtime_error);
+
+    {
+        std::ofstream file("container_invalid.lrc", std::ios::binary);
+        std::vector<char> junk(128, 'x');
+        file.write(junk.data(), junk.size());
+    }
+    EXPECT_THROW(ReferenceContainer("container_invalid.lrc"), std::runtime_error);
+
+    ReferenceContainerWriter writer("container_invalid.lrc");
+    writer.addChannel("a", x);
+    EXPECT_THROW(writer.addChannel("a", x), std::invalid_argument);
+    writer.close();
+    EXPECT_THROW(writer.addChannel("b", x), std::runtime_error);
+}
+
+TEST_F(ReferenceContainerTest, ForeignByteOrder)
+{
+    // Hand-built container as written on a host with the other byte order
+    auto swapped = [](auto value)
+    {
+        unsigned char bytes[sizeof(value)];
+        std::memcpy(bytes, &value, sizeof(value));
+        std::reverse(bytes, bytes + sizeof(value));
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    };
+
+    const std::vector<double> values = {1.5, -2.25, 1e10};
+    const std::string name = "v";
+    std::vector<char> file(kContainerHeaderSize, '\0');
+    auto put = [&](auto value)
+    {
+        const char *bytes = reinterpret_cast<const char *>(&value);
+        file.insert(file.end(), bytes, bytes + sizeof(value));
+    };
+
+    for (double value : values)
+        put(swapped(value));
+    const uint64_t toc_offset = file.size();
+    put(swapped(static_cast<uint32_t>(name.size())));
+    put(static_cast<uint8_t>(ContainerTypeTag::Float64));
+    put(static_cast<uint8_t>(ContainerEncoding::Raw));
+    put(static_cast<uint16_t>(0));
+    put(swapped(static_cast<uint64_t>(values.size())));
+    put(swapped(static_cast<uint64_t>(kContainerHeaderSize)));
+    put(swapped(static_cast<uint64_t>(values.size() * sizeof(double))));
+    file.insert(file.end(), name.begin(), name.end());
+    const uint64_t toc_size = file.size() - toc_offset;
+
+    std::memcpy(file.data(), kContainerMagic, sizeof(kContainerMagic));
+    const uint32_t header[] = {swapped(kContainerByteOrderMark), swapped(kContainerVersion)};
+    std::memcpy(file.data() + 8, header, sizeof(header));
+    const uint64_t header_sizes[] = {swapped(uint64_t(1)), swapped(toc_offset), swapped(toc_size)};
+    std::memcpy(file.data() + 16, header_sizes, sizeof(header_sizes));
+
+    {
+        std::ofstream out("container_swapped.lrc", std::ios::binary);
+        out.write(file.data(), file.size());
+    }
+
+    ReferenceContainer container("container_swapped.lrc");
+    EXPECT_TRUE(container.isByteSwapped());
+    EXPECT_EQ(container.load<double>("v"), values);
+    EXPECT_THROW(container.view<double>("v"), std::runtime_error);
+}
+
+TEST_F(ReferenceContainerTest, RejectsImplausibleChannelCount)
+{
+    std::vector<char> file;
+    {
+        std::ifstream in("container_reference.lrc", std::ios::binary);
+        file.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    // A corrupt count must not reach the allocator
+    const uint64_t channel_count = uint64_t(1) << 60;
+    std::memcpy(file.data() + 16, &channel_count, sizeof(channel_count));
+    {
+        std::ofstream out("container_invalid.lrc", std::ios::binary);
+        out.write(file.data(), file.size());
+    }
+
+    EXPECT_THROW(ReferenceContainer("container_invalid.lrc"), std::runtime_error);
+}
+
+TEST_F(ReferenceContainerTest, RejectsOverflowingElementCount)
+{
+    std::vector<char> file;
+    {
+        std::ifstream in("container_reference.lrc", std::ios::binary);
+        file.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    // The first entry is "time" with 1000 doubles. 2^61 + 1000 elements of
+    // 8 bytes wrap around to the same 8000 byte payload.
+    uint64_t toc_offset;
+    std::memcpy(&toc_offset, file.data() + 24, sizeof(toc_offset));
+    const uint64_t element_count = (uint64_t(1) << 61) + time.size();
+    std::memcpy(file.data() + toc_offset + 8, &element_count, sizeof(element_count));
+    {
+        std::ofstream out("container_invalid.lrc", std::ios::binary);
+        out.write(file.data(), file.size());
+    }
+
+    EXPECT_THROW(ReferenceContainer("container_invalid.lrc"), std::runtime_error);
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <vector>
+#include <filesystem>
+#include "reference_testing/reference_testing.h"
+
+using namespace lumos;
+
+class ReferenceHandleTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        for (size_t i = 0; i < 1000; ++i)
+            reference.push_back(0.5 * static_cast<double>(i));
+        saveBinaryVector(reference, "handle_reference.bin");
+    }
+
+    void TearDown() override
+    {
+        std::remove("handle_reference.bin");
+        std::remove("handle_truncated.bin");
+    }
+
+    std::vector<double> reference;
+};
+
+TEST_F(ReferenceHandleTest, ReadsHeaderOnly)
+{
+    const BinaryFileInfo info = readBinaryFileInfo("handle_reference.bin");
+    EXPECT_EQ(info.type_name, typeid(double).name());
+    EXPECT_EQ(info.element_size, sizeof(double));
+    EXPECT_EQ(info.element_count, reference.size());
+    EXPECT_EQ(info.payload_offset % kBinaryPayloadAlignment, 0u);
+    EXPECT_EQ(info.file_size, info.payload_offset + reference.size() * sizeof(double));
+
+    ReferenceHandle<double> handle("handle_reference.bin");
+    EXPECT_EQ(handle.size(), reference.size());
+    EXPECT_FALSE(handle.isLoaded());
+
+    // A size mismatch is rejected without reading the payload
+    std::vector<double> short_test(10, 0.0);
+    EXPECT_FALSE(isWithinBounds(short_test, handle, handle));
+    EXPECT_FALSE(handle.isLoaded());
+}
+
+TEST_F(ReferenceHandleTest, MaterialisesOnAccess)
+{
+    ReferenceHandle<double> handle("handle_reference.bin");
+
+    EXPECT_EQ(handle.slice(100, 110), std::vector<double>(reference.begin() + 100, reference.begin() + 110));
+    EXPECT_TRUE(handle.slice(5, 5).empty());
+    EXPECT_FALSE(handle.isLoaded());
+
+    EXPECT_DOUBLE_EQ(handle[3], reference[3]);
+    EXPECT_TRUE(handle.isLoaded());
+    EXPECT_EQ(handle.load(), reference);
+    EXPECT_EQ(handle.slice(990, 1000), std::vector<double>(reference.end() - 10, reference.end()));
+    EXPECT_TRUE(isWithinBounds(reference, handle, handle));
+
+    handle.release();
+    EXPECT_FALSE(handle.isLoaded());
+    EXPECT_DOUBLE_EQ(handle.back(), reference.back());
+
+    EXPECT_THROW(handle.slice(10, 5), std::invalid_argument);
+    EXPECT_THROW(handle.slice(0, 1001), std::invalid_argument);
+}
+
+TEST_F(ReferenceHandleTest, ValidatesHeader)
+{
+    EXPECT_THROW(ReferenceHandle<float>("handle_reference.bin"), std::runtime_error);
+    EXPECT_THROW(ReferenceHandle<double>("handle_missing.bin"), std::runtime_error);
+    EXPECT_THROW(readBinaryFileInfo("handle_missing.bin"), std::runtime_error);
+
+    saveBinaryVector(reference, "handle_truncated.bin");
+    std::filesystem::resize_file("handle_truncated.bin", std::filesystem::file_size("handle_truncated.bin") - 1);
+    EXPECT_THROW(ReferenceHandle<double>("handle_truncated.bin"), std::runtime_error);
+}
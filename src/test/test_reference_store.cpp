@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <filesystem>
+#include "reference_testing/reference_testing.h"
+
+using namespace lumos;
+
+namespace
+{
+    size_t countFiles(const std::filesystem::path &directory)
+    {
+        return static_cast<size_t>(std::distance(std::filesystem::directory_iterator(directory),
+                                                 std::filesystem::directory_iterator()));
+    }
+}
+
+TEST(XXHash64Test, MatchesReferenceDigests)
+{
+    EXPECT_EQ(XXHash64::hash("", 0), 0xEF46DB3751D8E999ULL);
+    EXPECT_EQ(XXHash64::hash("a", 1), 0xD24EC4F1A98C6E5BULL);
+    EXPECT_EQ(XXHash64::hash("abc", 3), 0x44BC2CF5AD770999ULL);
+    EXPECT_EQ(hashToHex(0x44BC2CF5AD770999ULL), "44bc2cf5ad770999");
+
+    // Streaming in odd-sized pieces gives the one-shot digest
+    std::vector<unsigned char> data(1000);
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = static_cast<unsigned char>(i * 7);
+    XXHash64 hasher(5);
+    for (size_t i = 0; i < data.size(); i += 13)
+        hasher.update(data.data() + i, std::min<size_t>(13, data.size() - i));
+    EXPECT_EQ(hasher.digest(), XXHash64::hash(data.data(), data.size(), 5));
+}
+
+class ReferenceStoreTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        std::filesystem::remove_all(root);
+        for (size_t i = 0; i < 1000; ++i)
+            x.push_back(0.001 * static_cast<double>(i));
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(root);
+    }
+
+    const std::string root = "reference_store_test";
+    std::vector<double> x;
+};
+
+TEST_F(ReferenceStoreTest, PutAndGet)
+{
+    ReferenceStore store(root);
+    EXPECT_FALSE(store.contains("x_ref"));
+
+    const uint64_t hash = store.put("x_ref", x);
+    EXPECT_TRUE(store.contains("x_ref"));
+    EXPECT_EQ(store.entry("x_ref").object_hash, hash);
+    EXPECT_EQ(store.get<double>("x_ref"), x);
+
+    EXPECT_THROW(store.get<double>("missing"), std::runtime_error);
+    EXPECT_THROW(store.get<float>("x_ref"), std::runtime_error);
+    EXPECT_THROW(store.put("../escape", x), std::invalid_argument);
+}
+
+TEST_F(ReferenceStoreTest, DeduplicatesAndSkipsUnchangedWrites)
+{
+    ReferenceStore store(root);
+    store.put("a", x);
+    store.put("b", x);
+    EXPECT_EQ(countFiles(root + "/objects"), 1u);
+
+    const auto object_time = std::filesystem::last_write_time(root + "/objects/" +
+                                                              hashToHex(store.entry("a").object_hash) + ".bin");
+    const auto ref_time = std::filesystem::last_write_time(root + "/refs/a");
+
+    // Regenerating identical data touches nothing
+    store.put("a", x);
+    EXPECT_EQ(std::filesystem::last_write_time(root + "/objects/" + hashToHex(store.entry("a").object_hash) + ".bin"),
+              object_time);
+    EXPECT_EQ(std::filesystem::last_write_time(root + "/refs/a"), ref_time);
+
+    // Changed data gets a new object and an updated ref
+    std::vector<double> changed(x);
+    changed[10] += 1.0;
+    store.put("a", changed);
+    EXPECT_EQ(countFiles(root + "/objects"), 2u);
+    EXPECT_EQ(store.get<double>("a"), changed);
+    EXPECT_EQ(store.get<double>("b"), x);
+
+    // Same bytes as another type are a different object
+    std::vector<float> as_float(2 * x.size());
+    std::memcpy(as_float.data(), x.data(), x.size() * sizeof(double));
+    store.put("f", as_float);
+    EXPECT_EQ(countFiles(root + "/objects"), 3u);
+}
+
+TEST_F(ReferenceStoreTest, DetectsCorruption)
+{
+    ReferenceStore store(root);
+    const uint64_t hash = store.put("x_ref", x);
+
+    const std::string object = root + "/objects/" + hashToHex(hash) + ".bin";
+    {
+        std::fstream file(object, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(-3, std::ios::end);
+        file.put('\x7f');
+    }
+
+    EXPECT_THROW(store.get<double>("x_ref"), std::runtime_error);
+}
+
+TEST_F(ReferenceStoreTest, GetOrGenerateUsesParameterHash)
+{
+    ReferenceStore store(root);
+    size_t generated = 0;
+    auto generate = [&]()
+    {
+        generated++;
+        return x;
+    };
+
+    EXPECT_EQ(store.getOrGenerate<double>("x_ref", 1, generate), x);
+    EXPECT_EQ(store.getOrGenerate<double>("x_ref", 1, generate), x);
+    EXPECT_EQ(generated, 1u);
+
+    EXPECT_EQ(store.getOrGenerate<double>("x_ref", 2, generate), x);
+    EXPECT_EQ(generated, 2u);
+    EXPECT_EQ(store.entry("x_ref").parameter_hash, 2u);
+}
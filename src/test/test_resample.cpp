@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <algorithm>
+#include <memory_resource>
+#include "reference_testing/reference_testing.h"
+
+using namespace lumos;
+
+class ResampleTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        time_vec = {0.0, 1.0, 1.0, 2.0, 3.0, 4.0};
+        value_vec = {0.0, 10.0, 12.0, 5.0, 15.0, 20.0};
+    }
+
+    std::vector<double> time_vec;
+    std::vector<double> value_vec;
+};
+
+TEST_F(ResampleTest, LinearMatchesInterpolateAtTime)
+{
+    std::vector<double> query_times;
+    for (double t = -1.0; t <= 5.0; t += 0.0625)
+    {
+        query_times.push_back(t);
+    }
+
+    std::vector<double> output(query_times.size());
+    resample(query_times, time_vec, value_vec, output);
+
+    for (size_t i = 0; i < query_times.size(); ++i)
+    {
+        EXPECT_EQ(output[i], interpolateAtTime(query_times[i], time_vec, value_vec)) << "t = " << query_times[i];
+    }
+}
+
+TEST_F(ResampleTest, LinearRandomQueries)
+{
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> step(0.0, 0.1);
+    std::uniform_real_distribution<double> value(-1.0, 1.0);
+
+    std::vector<double> ref_time(300), ref_value(300);
+    double t = 0.0;
+    for (size_t i = 0; i < ref_time.size(); ++i)
+    {
+        t += step(rng);
+        ref_time[i] = t;
+        ref_value[i] = value(rng);
+    }
+
+    std::uniform_real_distribution<double> query(-1.0, t + 1.0);
+    std::vector<double> query_times(1001);
+    for (double &q : query_times)
+    {
+        q = query(rng);
+    }
+
+    std::vector<double> output(query_times.size());
+    resample(query_times, ref_time, ref_value, output);
+    for (size_t i = 0; i < query_times.size(); ++i)
+    {
+        ASSERT_EQ(output[i], interpolateAtTime(query_times[i], ref_time, ref_value));
+    }
+
+    std::sort(query_times.begin(), query_times.end());
+    resample(query_times, ref_time, ref_value, output);
+    for (size_t i = 0; i < query_times.size(); ++i)
+    {
+        ASSERT_EQ(output[i], interpolateAtTime(query_times[i], ref_time, ref_value));
+    }
+}
+
+TEST_F(ResampleTest, ZeroOrderHold)
+{
+    std::vector<double> query_times = {-1.0, 0.0, 0.5, 1.0, 1.5, 2.0, 3.99, 4.0, 5.0, 0.25};
+    std::vector<double> expected = {0.0, 0.0, 0.0, 12.0, 12.0, 5.0, 15.0, 20.0, 20.0, 0.0};
+    std::vector<double> output(query_times.size());
+
+    resample(query_times, time_vec, value_vec, output, InterpolationMode::ZeroOrderHold);
+
+    for (size_t i = 0; i < query_times.size(); ++i)
+    {
+        EXPECT_EQ(output[i], expected[i]) << "t = " << query_times[i];
+    }
+}
+
+TEST_F(ResampleTest, FloatType)
+{
+    std::vector<float> time_f = {0.0f, 1.0f, 2.0f};
+    std::vector<float> value_f = {0.0f, 10.0f, 5.0f};
+    std::vector<float> query_times = {0.0f, 0.25f, 0.5f, 1.0f, 1.5f, 2.0f, 2.5f, 0.75f, 1.25f};
+    std::vector<float> output(query_times.size());
+
+    resample(query_times, time_f, value_f, output);
+
+    for (size_t i = 0; i < query_times.size(); ++i)
+    {
+        EXPECT_EQ(output[i], interpolateAtTime(query_times[i], time_f, value_f));
+    }
+}
+
+TEST_F(ResampleTest, ErrorCases)
+{
+    std::vector<double> query_times = {0.5, 1.5};
+    std::vector<double> wrong_size_output(1);
+    std::vector<double> output(2);
+    std::vector<double> empty_time, empty_value;
+
+    EXPECT_THROW(resample(query_times, time_vec, value_vec, wrong_size_output), std::invalid_argument);
+    EXPECT_THROW(resample(query_times, empty_time, empty_value, output), std::invalid_argument);
+}
+
+TEST_F(ResampleTest, AcceptsMixedContiguousRanges)
+{
+    std::vector<double> query_times = {-0.5, 0.25, 1.0, 1.5, 3.75, 4.5};
+    std::pmr::vector<double> pmr_time(time_vec.begin(), time_vec.end());
+    const Span<const double> value_span(value_vec);
+
+    std::vector<double> expected(query_times.size());
+    resample(query_times, time_vec, value_vec, expected);
+
+    std::pmr::vector<double> pmr_output(query_times.size());
+    resample(query_times, pmr_time, value_span, pmr_output);
+    std::vector<double> span_storage(query_times.size());
+    resample(Span<const double>(query_times), Span<const double>(time_vec), value_vec, Span<double>(span_storage));
+
+    for (size_t i = 0; i < query_times.size(); ++i)
+    {
+        EXPECT_EQ(pmr_output[i], expected[i]);
+        EXPECT_EQ(span_storage[i], expected[i]);
+    }
+}
+
+TEST_F(ResampleTest, LinearIsBitIdenticalAcrossSimdLevels)
+{
+    std::vector<double> query_times;
+    for (double t = -1.0; t <= 5.0; t += 0.01)
+    {
+        query_times.push_back(t);
+    }
+    std::vector<float> query_f(query_times.begin(), query_times.end());
+    std::vector<float> time_f(time_vec.begin(), time_vec.end());
+    std::vector<float> value_f(value_vec.begin(), value_vec.end());
+
+    std::vector<double> output(query_times.size());
+    std::vector<float> output_f(query_times.size());
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::Sse2, SimdLevel::Avx2, SimdLevel::Avx512})
+    {
+        setSimdLevel(level);
+        resample(query_times, time_vec, value_vec, output);
+        resample(query_f, time_f, value_f, output_f);
+        for (size_t i = 0; i < query_times.size(); ++i)
+        {
+            ASSERT_EQ(output[i], interpolateAtTime(query_times[i], time_vec, value_vec))
+                << "level = " << static_cast<int>(activeSimdLevel());
+            ASSERT_EQ(output_f[i], interpolateAtTime(query_f[i], time_f, value_f))
+                << "level = " << static_cast<int>(activeSimdLevel());
+        }
+    }
+    setSimdLevel(detectSimdLevel());
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+#include <cmath>
+#include "reference_testing/reference_testing.h"
+
+using namespace lumos;
+
+class SignalSetTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        for (size_t i = 0; i < 50; ++i)
+        {
+            const double t = 0.1 * static_cast<double>(i);
+            time_vec.push_back(t);
+            sensor_x.push_back(std::sin(t) + 0.01 * std::sin(10 * t));
+            sensor_y.push_back(std::cos(t) + 0.02 * std::cos(15 * t));
+            ref_x.push_back(std::sin(t));
+        }
+    }
+
+    void TearDown() override
+    {
+        std::remove("signal_time.bin");
+        std::remove("signal_x.bin");
+        std::remove("signal_y.bin");
+        std::remove("signal_short.bin");
+    }
+
+    std::vector<double> time_vec, sensor_x, sensor_y, ref_x;
+};
+
+TEST_F(SignalSetTest, StoresAlignedChannels)
+{
+    SignalSet<double> signals(time_vec, std::vector<std::pair<std::string, std::vector<double>>>{
+                                            {"sensor_x", sensor_x}, {"sensor_y", sensor_y}});
+
+    EXPECT_EQ(signals.size(), time_vec.size());
+    EXPECT_EQ(signals.channelCount(), 2u);
+    EXPECT_EQ(signals.channelNames()[1], "sensor_y");
+    EXPECT_TRUE(signals.hasChannel("sensor_x"));
+    EXPECT_FALSE(signals.hasChannel("sensor_z"));
+    EXPECT_EQ(signals.channelIndex("sensor_y"), 1u);
+
+    EXPECT_EQ(std::vector<double>(signals.time().begin(), signals.time().end()), time_vec);
+    EXPECT_EQ(std::vector<double>(signals["sensor_x"].begin(), signals["sensor_x"].end()), sensor_x);
+    EXPECT_EQ(std::vector<double>(signals.channel(1).begin(), signals.channel(1).end()), sensor_y);
+
+    for (const Span<const double> row : {signals.time(), signals.channel(0), signals.channel(1)})
+    {
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(row.data()) % SignalSet<double>::kAlignment, 0u);
+    }
+
+    // Channels are contiguous rows of one arena
+    EXPECT_EQ(signals.channel(1).data() - signals.channel(0).data(),
+              signals.channel(0).data() - signals.time().data());
+
+    signals["sensor_x"][3] = 42.0;
+    EXPECT_EQ(signals.channel(0)[3], 42.0);
+
+    EXPECT_THROW(signals["sensor_z"], std::invalid_argument);
+    EXPECT_THROW(signals.channel(2), std::invalid_argument);
+    EXPECT_THROW(SignalSet<double>(10, {"a", "a"}), std::invalid_argument);
+    EXPECT_THROW(SignalSet<double>(time_vec, std::vector<std::pair<std::string, std::vector<double>>>{
+                                                 {"short", std::vector<double>(3)}}),
+                 std::invalid_argument);
+}
+
+TEST_F(SignalSetTest, ChecksRunOnChannels)
+{
+    const SignalSet<double> signals(time_vec, std::vector<std::pair<std::string, std::vector<double>>>{
+                                                  {"sensor_x", sensor_x}, {"ref_x", ref_x}});
+
+    std::vector<double> x_min, x_max;
+    for (double value : ref_x)
+    {
+        x_min.push_back(value - 0.05);
+        x_max.push_back(value + 0.05);
+    }
+
+    EXPECT_TRUE(isWithinBounds(signals["sensor_x"], Span<const double>(x_min), Span<const double>(x_max)));
+    EXPECT_TRUE(isWithinBounds(signals.time(), signals["sensor_x"], Span<const double>(time_vec),
+                               Span<const double>(x_min), Span<const double>(time_vec), Span<const double>(x_max)));
+    EXPECT_TRUE(isVarianceWithinThreshold(signals["sensor_x"], signals["ref_x"], 0.001));
+    EXPECT_TRUE(isMeanDifferenceWithinThreshold(signals["sensor_x"], signals["ref_x"], 0.01));
+    EXPECT_TRUE(hasAtLeastNSamplesAboveThreshold(signals["sensor_x"], 0.5, 10));
+    EXPECT_TRUE(hasAtLeastNConsecutiveSamplesBelowThreshold(signals["ref_x"], 0.0, 10));
+    EXPECT_TRUE(isAboveThresholdForAtLeast(signals.time(), signals["ref_x"], 0.5, 1.0));
+}
+
+TEST_F(SignalSetTest, LoadsFromReferenceBinaries)
+{
+    saveBinaryVector(time_vec, "signal_time.bin");
+    saveBinaryVector(sensor_x, "signal_x.bin");
+    saveBinaryVector(sensor_y, "signal_y.bin");
+    saveBinaryVector(std::vector<double>(3, 0.0), "signal_short.bin");
+
+    const SignalSet<double> signals =
+        SignalSet<double>::load("signal_time.bin", {{"x", "signal_x.bin"}, {"y", "signal_y.bin"}});
+    EXPECT_EQ(signals.size(), time_vec.size());
+    EXPECT_EQ(std::vector<double>(signals.time().begin(), signals.time().end()), time_vec);
+    EXPECT_EQ(std::vector<double>(signals["x"].begin(), signals["x"].end()), sensor_x);
+    EXPECT_EQ(std::vector<double>(signals["y"].begin(), signals["y"].end()), sensor_y);
+
+    EXPECT_THROW(SignalSet<double>::load("signal_time.bin", {{"short", "signal_short.bin"}}), std::runtime_error);
+    EXPECT_THROW(SignalSet<float>::load("signal_time.bin", {}), std::runtime_error);
+    EXPECT_THROW(SignalSet<double>::load("signal_time.bin", {{"missing", "signal_missing.bin"}}), std::runtime_error);
+
+    const SignalSet<double> empty(0, {"a"});
+    EXPECT_EQ(empty.size(), 0u);
+    EXPECT_TRUE(empty["a"].empty());
+}
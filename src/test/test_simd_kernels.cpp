@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "reference_testing/reference_testing.h"
+
+using namespace lumos;
+
+namespace
+{
+    const std::vector<SimdLevel> kAllLevels = {SimdLevel::Scalar, SimdLevel::Sse2, SimdLevel::Avx2, SimdLevel::Avx512};
+}
+
+template <typename T>
+class SimdKernelsTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        std::mt19937 rng(11);
+        std::uniform_real_distribution<T> dist(T(-1), T(1));
+        // Odd length so every implementation exercises its tail handling
+        for (size_t i = 0; i < 1037; ++i)
+        {
+            a.push_back(dist(rng));
+            b.push_back(dist(rng));
+            min_bounds.push_back(T(-1));
+            max_bounds.push_back(T(1));
+        }
+    }
+
+    void TearDown() override
+    {
+        setSimdLevel(detectSimdLevel());
+    }
+
+    std::vector<T> a, b, min_bounds, max_bounds;
+};
+
+using FloatTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(SimdKernelsTest, FloatTypes);
+
+TYPED_TEST(SimdKernelsTest, SumSquaredDifferenceIsBitIdenticalAcrossLevels)
+{
+    setSimdLevel(SimdLevel::Scalar);
+    for (size_t n : {0u, 1u, 7u, 16u, 17u, 1037u})
+    {
+        setSimdLevel(SimdLevel::Scalar);
+        const TypeParam expected = sumSquaredDifference(this->a.data(), this->b.data(), n);
+
+        for (SimdLevel level : kAllLevels)
+        {
+            setSimdLevel(level);
+            EXPECT_EQ(sumSquaredDifference(this->a.data(), this->b.data(), n), expected)
+                << "n = " << n << ", level = " << static_cast<int>(activeSimdLevel());
+        }
+    }
+
+    TypeParam sequential = TypeParam(0);
+    for (size_t i = 0; i < this->a.size(); ++i)
+    {
+        sequential += (this->a[i] - this->b[i]) * (this->a[i] - this->b[i]);
+    }
+    EXPECT_NEAR(sumSquaredDifference(this->a.data(), this->b.data(), this->a.size()), sequential,
+                std::abs(sequential) * TypeParam(1e-4));
+}
+
+TYPED_TEST(SimdKernelsTest, FindFirstOutsideBounds)
+{
+    for (SimdLevel level : kAllLevels)
+    {
+        setSimdLevel(level);
+        EXPECT_EQ(findFirstOutsideBounds(this->a.data(), this->min_bounds.data(), this->max_bounds.data(), this->a.size()),
+                  this->a.size());
+
+        for (size_t violation : {0u, 5u, 16u, 1000u, 1036u})
+        {
+            std::vector<TypeParam> test = this->a;
+            test[violation] = violation % 2 == 0 ? TypeParam(2) : TypeParam(-2);
+            test[1036] = TypeParam(3);
+            EXPECT_EQ(findFirstOutsideBounds(test.data(), this->min_bounds.data(), this->max_bounds.data(), test.size()),
+                      violation);
+        }
+    }
+}
+
+TYPED_TEST(SimdKernelsTest, CountThresholds)
+{
+    size_t expected_above = 0;
+    size_t expected_below = 0;
+    for (TypeParam value : this->a)
+    {
+        expected_above += value > TypeParam(0.25) ? 1 : 0;
+        expected_below += value < TypeParam(0.25) ? 1 : 0;
+    }
+
+    for (SimdLevel level : kAllLevels)
+    {
+        setSimdLevel(level);
+        EXPECT_EQ(countAboveThreshold(this->a.data(), this->a.size(), TypeParam(0.25)), expected_above);
+        EXPECT_EQ(countBelowThreshold(this->a.data(), this->a.size(), TypeParam(0.25)), expected_below);
+    }
+}
+
+TYPED_TEST(SimdKernelsTest, CheckersAgreeAcrossLevels)
+{
+    std::vector<bool> verdicts;
+    for (SimdLevel level : kAllLevels)
+    {
+        setSimdLevel(level);
+        verdicts.push_back(isWithinBounds(this->a, this->min_bounds, this->max_bounds));
+        verdicts.push_back(isVarianceWithinThreshold(this->a, this->b, TypeParam(0.6)));
+        verdicts.push_back(hasAtLeastNSamplesAboveThreshold(this->a, TypeParam(0.5), 200));
+        verdicts.push_back(hasAtLeastNSamplesBelowThreshold(this->a, TypeParam(-0.5), 300));
+    }
+
+    for (size_t i = 4; i < verdicts.size(); ++i)
+    {
+        EXPECT_EQ(verdicts[i], verdicts[i % 4]);
+    }
+    EXPECT_TRUE(verdicts[0]);
+}
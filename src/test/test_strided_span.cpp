@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <numeric>
+#include <cmath>
+#include "reference_testing/reference_testing.h"
+
+using namespace lumos;
+
+namespace
+{
+    struct LogRow
+    {
+        double time;
+        double x;
+        float status;
+        double y;
+    };
+}
+
+class StridedSpanTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        for (size_t i = 0; i < 200; ++i)
+        {
+            const double t = 0.01 * static_cast<double>(i);
+            rows.push_back({t, std::sin(t), 1.0f, std::cos(t)});
+            interleaved.push_back(t);
+            interleaved.push_back(std::sin(t));
+            interleaved.push_back(std::cos(t));
+            time.push_back(t);
+            x.push_back(std::sin(t));
+            y.push_back(std::cos(t));
+        }
+        for (double value : x)
+        {
+            x_min.push_back(value - 0.1);
+            x_max.push_back(value + 0.1);
+        }
+    }
+
+    std::vector<LogRow> rows;
+    std::vector<double> interleaved;
+    std::vector<double> time, x, y, x_min, x_max;
+};
+
+TEST_F(StridedSpanTest, ViewsFieldsAndChannels)
+{
+    const StridedSpan<const double> x_field = fieldSpan(rows.data(), rows.size(), &LogRow::x);
+    const StridedSpan<const double> x_channel = interleavedChannel(interleaved.data(), time.size(), 3, 1);
+
+    ASSERT_EQ(x_field.size(), x.size());
+    ASSERT_EQ(x_channel.size(), x.size());
+    EXPECT_EQ(x_field.stride(), static_cast<std::ptrdiff_t>(sizeof(LogRow)));
+    EXPECT_EQ(x_channel.stride(), static_cast<std::ptrdiff_t>(3 * sizeof(double)));
+    EXPECT_EQ(&x_field[5], &rows[5].x);
+    EXPECT_EQ(&x_channel[5], &interleaved[16]);
+
+    EXPECT_EQ(std::vector<double>(x_field.begin(), x_field.end()), x);
+    EXPECT_EQ(std::vector<double>(x_channel.begin(), x_channel.end()), x);
+    EXPECT_EQ(x_channel.end() - x_channel.begin(), static_cast<std::ptrdiff_t>(x.size()));
+    EXPECT_DOUBLE_EQ(x_field.subspan(10, 5)[2], x[12]);
+    EXPECT_EQ(x_field.subspan(10, 5).size(), 5u);
+
+    const StridedSpan<const float> status = fieldSpan(rows.data(), rows.size(), &LogRow::status);
+    EXPECT_FLOAT_EQ(std::accumulate(status.begin(), status.end(), 0.0f), 200.0f);
+    EXPECT_TRUE(fieldSpan(rows.data(), 0, &LogRow::x).empty());
+
+    // Default-constructed iterators are equal and subtract to zero
+    const StridedIterator<const double> first, second;
+    EXPECT_TRUE(first == second);
+    EXPECT_EQ(second - first, 0);
+    EXPECT_FALSE(first < second);
+
+    // A zero stride would give size() elements but an empty iteration
+    const double value = 2.0;
+    EXPECT_THROW(StridedSpan<const double>(&value, 3, 0), std::invalid_argument);
+}
+
+TEST_F(StridedSpanTest, CheckersRunInPlace)
+{
+    const StridedSpan<const double> t_field = fieldSpan(rows.data(), rows.size(), &LogRow::time);
+    const StridedSpan<const double> x_field = fieldSpan(rows.data(), rows.size(), &LogRow::x);
+    const StridedSpan<const double> y_field = fieldSpan(rows.data(), rows.size(), &LogRow::y);
+
+    EXPECT_EQ(isWithinBounds(x_field, x_min, x_max), isWithinBounds(x, x_min, x_max));
+    EXPECT_TRUE(isWithinBounds(x_field, x_min, x_max));
+    EXPECT_FALSE(isWithinBounds(y_field, x_min, x_max));
+    EXPECT_TRUE(isWithinBounds(t_field, x_field, time, x_min, time, x_max));
+
+    // Bounds given as strided views as well
+    std::vector<double> bounds_rows;
+    for (size_t i = 0; i < time.size(); ++i)
+    {
+        bounds_rows.push_back(time[i]);
+        bounds_rows.push_back(x_min[i]);
+        bounds_rows.push_back(x_max[i]);
+    }
+    const StridedSpan<const double> b_time = interleavedChannel(bounds_rows.data(), time.size(), 3, 0);
+    const StridedSpan<const double> b_min = interleavedChannel(bounds_rows.data(), time.size(), 3, 1);
+    const StridedSpan<const double> b_max = interleavedChannel(bounds_rows.data(), time.size(), 3, 2);
+    EXPECT_TRUE(isWithinBounds(x_field, b_min, b_max));
+    EXPECT_TRUE(isWithinBounds(t_field, x_field, b_time, b_min, b_time, b_max));
+    EXPECT_FALSE(isWithinBounds(t_field, y_field, b_time, b_min, b_time, b_max));
+
+    EXPECT_EQ(isVarianceWithinThreshold(x_field, y_field, 0.5), isVarianceWithinThreshold(x, y, 0.5));
+    EXPECT_EQ(isMeanDifferenceWithinThreshold(x_field, y_field, 0.1), isMeanDifferenceWithinThreshold(x, y, 0.1));
+    EXPECT_EQ(hasAtLeastNSamplesAboveThreshold(x_field, 0.5, 100), hasAtLeastNSamplesAboveThreshold(x, 0.5, 100));
+    EXPECT_EQ(hasAtLeastNConsecutiveSamplesBelowThreshold(y_field, 0.9, 50),
+              hasAtLeastNConsecutiveSamplesBelowThreshold(y, 0.9, 50));
+    EXPECT_TRUE(isAboveThresholdForAtLeast(t_field, x_field, 0.5, 1.0));
+
+    const ViolationReport<double> report = checkWithinBounds(y_field, x_min, x_max);
+    EXPECT_EQ(report.first_index, checkWithinBounds(y, x_min, x_max).first_index);
+
+    const IndexRange window = findTimeWindow(t_field, 0.5, 1.0);
+    EXPECT_EQ(window.begin, findTimeWindow(time, 0.5, 1.0).begin);
+    EXPECT_EQ(window.end, findTimeWindow(time, 0.5, 1.0).end);
+    EXPECT_TRUE(isWithinBounds(x_field.subspan(window.begin, window.size()),
+                               Span<const double>(x_min.data() + window.begin, window.size()),
+                               Span<const double>(x_max.data() + window.begin, window.size())));
+
+    OnlineWithinBounds<double> online;
+    online.push(x_field, b_min, b_max);
+    EXPECT_TRUE(online.verdict());
+}
+
+TEST_F(StridedSpanTest, VarianceMatchesContiguousBitForBit)
+{
+    const StridedSpan<const double> x_field = fieldSpan(rows.data(), rows.size(), &LogRow::x);
+    const StridedSpan<const double> y_field = fieldSpan(rows.data(), rows.size(), &LogRow::y);
+
+    const double contiguous_sum = sumSquaredDifference(x.data(), y.data(), x.size());
+    EXPECT_EQ(detail::sumSquaredDifferenceIndexed<double>(x_field, y_field, x_field.size()), contiguous_sum);
+
+    // The variance at exactly the contiguous result passes, one ulp below fails
+    const double variance = contiguous_sum / static_cast<double>(x.size());
+    const double just_below = std::nextafter(variance, 0.0);
+    EXPECT_TRUE(isVarianceWithinThreshold(x, y, variance));
+    EXPECT_TRUE(isVarianceWithinThreshold(x_field, y_field, variance));
+    EXPECT_FALSE(isVarianceWithinThreshold(x, y, just_below));
+    EXPECT_FALSE(isVarianceWithinThreshold(x_field, y_field, just_below));
+}
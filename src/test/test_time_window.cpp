@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <vector>
+#include "reference_testing/reference_testing.h"
+
+using namespace lumos;
+
+class TimeWindowTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // 0.01 s timebase over 100 s with a step response settling at 1.0
+        for (size_t i = 0; i < 10000; ++i)
+        {
+            const double t = 0.01 * static_cast<double>(i);
+            time.push_back(t);
+            values.push_back(t < 1.0 ? 0.0 : 1.0 + 0.5 * std::exp(-(t - 1.0)) * std::cos(5.0 * t));
+        }
+        saveBinaryVector(time, "window_time.bin");
+        saveBinaryVector(values, "window_values.bin");
+    }
+
+    void TearDown() override
+    {
+        std::remove("window_time.bin");
+        std::remove("window_values.bin");
+        std::remove("window_container.lrc");
+    }
+
+    std::vector<double> time;
+    std::vector<double> values;
+};
+
+TEST_F(TimeWindowTest, FindsWindowInSortedTimebase)
+{
+    IndexRange window = findTimeWindow(time, 1.0, 2.0);
+    EXPECT_EQ(window.begin, 100u);
+    EXPECT_EQ(window.end, 201u);
+    EXPECT_EQ(window.size(), 101u);
+
+    // Bounds between samples
+    window = findTimeWindow(time, 0.995, 1.005);
+    EXPECT_EQ(window.begin, 100u);
+    EXPECT_EQ(window.end, 101u);
+
+    EXPECT_TRUE(findTimeWindow(time, 0.001, 0.009).empty());
+    EXPECT_EQ(findTimeWindow(time, -5.0, 1000.0).size(), time.size());
+    EXPECT_TRUE(findTimeWindow(time, 200.0, 300.0).empty());
+    EXPECT_TRUE(findTimeWindow(std::vector<double>(), 0.0, 1.0).empty());
+    EXPECT_THROW(findTimeWindow(time, 2.0, 1.0), std::invalid_argument);
+
+    const Span<const double> settle = windowOf(values, findTimeWindow(time, 10.0, 20.0));
+    EXPECT_EQ(settle.size(), 1001u);
+    EXPECT_EQ(settle.data(), values.data() + 1000);
+    EXPECT_TRUE(hasAtLeastNConsecutiveSamplesAboveThreshold(settle, 0.99, settle.size()));
+    EXPECT_FALSE(hasAtLeastNConsecutiveSamplesAboveThreshold(values, 0.99, settle.size() * 10));
+}
+
+TEST_F(TimeWindowTest, SlicesFiles)
+{
+    EXPECT_EQ(loadBinaryVectorSlice<double>("window_values.bin", 1000, 1100),
+              std::vector<double>(values.begin() + 1000, values.begin() + 1100));
+    EXPECT_TRUE(loadBinaryVectorSlice<double>("window_values.bin", 0, 0).empty());
+    EXPECT_THROW(loadBinaryVectorSlice<double>("window_values.bin", 0, 10001), std::invalid_argument);
+    EXPECT_THROW(loadBinaryVectorSlice<float>("window_values.bin", 0, 1), std::runtime_error);
+
+    ReferenceHandle<double> time_handle("window_time.bin");
+    ReferenceHandle<double> value_handle("window_values.bin");
+    const IndexRange window = findTimeWindow(time_handle, 10.0, 20.0);
+    EXPECT_FALSE(time_handle.isLoaded());
+    EXPECT_EQ(window.begin, findTimeWindow(time, 10.0, 20.0).begin);
+    EXPECT_EQ(window.end, findTimeWindow(time, 10.0, 20.0).end);
+
+    const std::vector<double> settle = value_handle.slice(window.begin, window.end);
+    EXPECT_FALSE(value_handle.isLoaded());
+    EXPECT_TRUE(hasAtLeastNConsecutiveSamplesAboveThreshold(settle, 0.99, settle.size()));
+}
+
+TEST_F(TimeWindowTest, SlicesContainerChannels)
+{
+    {
+        ReferenceContainerWriter writer("window_container.lrc");
+        writer.addChannel("time", time, ContainerEncoding::DeltaOfDelta);
+        writer.addChannel("raw", values);
+        writer.addChannel("raw_time", time);
+        writer.addChannel("xor", values, ContainerEncoding::XorFloat);
+    }
+
+    ReferenceContainer container("window_container.lrc");
+    const std::vector<double> expected(values.begin() + 4000, values.begin() + 8300);
+    EXPECT_EQ(container.loadSlice<double>("raw", 4000, 8300), expected);
+    EXPECT_EQ(container.loadSlice<double>("xor", 4000, 8300), expected);
+    EXPECT_EQ(container.loadSlice<double>("xor", 9999, 10000), std::vector<double>(1, values.back()));
+    EXPECT_EQ(container.loadSlice<double>("time", 0, 10000), time);
+    EXPECT_TRUE(container.loadSlice<double>("xor", 50, 50).empty());
+    EXPECT_THROW(container.loadSlice<double>("raw", 5, 10001), std::invalid_argument);
+
+    const IndexRange window = findTimeWindow(container.view<double>("raw_time"), 40.0, 83.0);
+    EXPECT_EQ(windowOf(container.view<double>("raw"), window).size(), 4301u);
+}
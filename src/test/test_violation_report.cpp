@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <cmath>
+#include "reference_testing/reference_testing.h"
+
+using namespace lumos;
+
+class ViolationReportTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        for (size_t i = 0; i < 10000; ++i)
+        {
+            time.push_back(0.001 * static_cast<double>(i));
+            test.push_back(0.0);
+            min_bounds.push_back(-1.0);
+            max_bounds.push_back(1.0);
+        }
+    }
+
+    std::vector<double> time, test, min_bounds, max_bounds;
+};
+
+TEST_F(ViolationReportTest, PassingReport)
+{
+    ViolationReport<double> report = checkWithinBounds(test, min_bounds, max_bounds);
+
+    EXPECT_TRUE(report.passed);
+    EXPECT_EQ(report.first_index, ViolationReport<double>::kNoViolation);
+    EXPECT_TRUE(std::isnan(report.first_time));
+    EXPECT_EQ(report.violation_count, 0u);
+    EXPECT_EQ(report.worst_margin, 0.0);
+    EXPECT_EQ(report.longest_run, 0u);
+}
+
+TEST_F(ViolationReportTest, CollectsAllFieldsInOnePass)
+{
+    test[100] = 1.5;
+    for (size_t i = 5000; i < 5007; ++i)
+        test[i] = -1.25;
+    test[9999] = 3.0;
+
+    ViolationReport<double> report = checkWithinBounds(test, min_bounds, max_bounds);
+
+    EXPECT_FALSE(report.passed);
+    EXPECT_EQ(report.first_index, 100u);
+    EXPECT_EQ(report.violation_count, 9u);
+    EXPECT_DOUBLE_EQ(report.worst_margin, 2.0);
+    EXPECT_EQ(report.worst_index, 9999u);
+    EXPECT_EQ(report.longest_run, 7u);
+    EXPECT_EQ(report.passed, isWithinBounds(test, min_bounds, max_bounds));
+}
+
+TEST_F(ViolationReportTest, FirstViolationOnly)
+{
+    test[100] = 1.5;
+    test[200] = 5.0;
+
+    ViolationReport<double> report =
+        checkWithinBounds(test, min_bounds, max_bounds, ViolationReportOptions::firstViolationOnly());
+
+    EXPECT_FALSE(report.passed);
+    EXPECT_EQ(report.first_index, 100u);
+    EXPECT_EQ(report.violation_count, 0u);
+    EXPECT_EQ(report.worst_index, ViolationReport<double>::kNoViolation);
+}
+
+TEST_F(ViolationReportTest, SelectedFields)
+{
+    test[10] = 2.0;
+    test[11] = 2.0;
+    test[20] = 4.0;
+
+    ViolationReportOptions options;
+    options.worst_margin = false;
+    ViolationReport<double> report = checkWithinBounds(test, min_bounds, max_bounds, options);
+
+    EXPECT_EQ(report.violation_count, 3u);
+    EXPECT_EQ(report.longest_run, 2u);
+    EXPECT_EQ(report.worst_margin, 0.0);
+}
+
+TEST_F(ViolationReportTest, NonContiguousRangesMatchContiguous)
+{
+    test[3] = 1.1;
+    test[4] = 1.2;
+    test[700] = -7.0;
+
+    // Exposes no data(), so the scalar path is taken
+    struct IndexedRange
+    {
+        using value_type = double;
+        const std::vector<double> &values;
+        size_t size() const { return values.size(); }
+        double operator[](size_t i) const { return values[i]; }
+        std::vector<double>::const_iterator begin() const { return values.begin(); }
+        std::vector<double>::const_iterator end() const { return values.end(); }
+    };
+
+    ViolationReport<double> expected = checkWithinBounds(test, min_bounds, max_bounds);
+    ViolationReport<double> report =
+        checkWithinBounds(IndexedRange{test}, IndexedRange{min_bounds}, IndexedRange{max_bounds});
+
+    EXPECT_EQ(report.first_index, expected.first_index);
+    EXPECT_EQ(report.violation_count, expected.violation_count);
+    EXPECT_EQ(report.worst_margin, expected.worst_margin);
+    EXPECT_EQ(report.worst_index, expected.worst_index);
+    EXPECT_EQ(report.longest_run, expected.longest_run);
+}
+
+TEST_F(ViolationReportTest, TimeBasedReport)
+{
+    // Bounds on a coarser timebase
+    std::vector<double> bound_time = {0.0, 5.0, 10.0};
+    std::vector<double> bound_min = {-1.0, -1.0, -1.0};
+    std::vector<double> bound_max = {1.0, 1.0, 1.0};
+
+    test[2500] = 1.5;
+    test[2501] = 1.75;
+
+    ViolationReport<double> report = checkWithinBounds(time, test, bound_time, bound_min, bound_time, bound_max);
+
+    EXPECT_FALSE(report.passed);
+    EXPECT_EQ(report.first_index, 2500u);
+    EXPECT_DOUBLE_EQ(report.first_time, time[2500]);
+    EXPECT_EQ(report.violation_count, 2u);
+    EXPECT_DOUBLE_EQ(report.worst_margin, 0.75);
+    EXPECT_EQ(report.longest_run, 2u);
+    EXPECT_EQ(report.passed, isWithinBounds(time, test, bound_time, bound_min, bound_time, bound_max));
+}
+
+TEST_F(ViolationReportTest, SizeMismatchFails)
+{
+    std::vector<double> short_bounds(5, 0.0);
+    ViolationReport<double> report = checkWithinBounds(test, short_bounds, short_bounds);
+
+    EXPECT_FALSE(report.passed);
+    EXPECT_EQ(report.first_index, ViolationReport<double>::kNoViolation);
+}
+
+TEST_F(ViolationReportTest, TimeBasedMinBoundsSizeMismatchFails)
+{
+    std::vector<double> bound_time = {0.0, 5.0, 10.0};
+    std::vector<double> bound_min = {-1.0, -1.0};
+    std::vector<double> bound_max = {1.0, 1.0, 1.0};
+
+    ViolationReport<double> report = checkWithinBounds(time, test, bound_time, bound_min, bound_time, bound_max);
+
+    EXPECT_FALSE(report.passed);
+    EXPECT_EQ(report.first_index, ViolationReport<double>::kNoViolation);
+    EXPECT_EQ(report.passed, isWithinBounds(time, test, bound_time, bound_min, bound_time, bound_max));
+}
+
+TEST_F(ViolationReportTest, TimeBasedMaxBoundsSizeMismatchFails)
+{
+    std::vector<double> bound_time = {0.0, 5.0, 10.0};
+    std::vector<double> bound_min = {-1.0, -1.0, -1.0};
+    std::vector<double> bound_max = {1.0, 1.0, 1.0, 1.0};
+
+    ViolationReport<double> report = checkWithinBounds(time, test, bound_time, bound_min, bound_time, bound_max);
+
+    EXPECT_FALSE(report.passed);
+    EXPECT_EQ(report.first_index, ViolationReport<double>::kNoViolation);
+    EXPECT_EQ(report.passed, isWithinBounds(time, test, bound_time, bound_min, bound_time, bound_max));
+}